@@ -0,0 +1,76 @@
+//! Catalog serialize/parse time and wire size per encoding
+//!
+//! Run with `cargo bench --bench catalog_encoding`. Uses std timing only so it needs
+//! no extra dependencies.
+
+use moq_wrapper::{Catalog, CatalogEncoding, CatalogType, TrackDefinition, TrackType};
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+const TRACK_COUNTS: [usize; 3] = [10, 1_000, 50_000];
+
+fn make_tracks(count: usize) -> Vec<TrackDefinition> {
+    (0..count)
+        .map(|i| {
+            let track_type = match i % 3 {
+                0 => TrackType::Video,
+                1 => TrackType::Audio,
+                _ => TrackType::Data,
+            };
+            TrackDefinition::new(format!("track-{:05}", i), (i % 8) as u32, track_type)
+        })
+        .collect()
+}
+
+/// Average duration of `f`, running it for roughly 200ms (at least 3 iterations)
+fn measure<F: FnMut()>(mut f: F) -> Duration {
+    let budget = Duration::from_millis(200);
+    let start = Instant::now();
+    let mut iterations = 0u32;
+    while iterations < 3 || start.elapsed() < budget {
+        f();
+        iterations += 1;
+    }
+    start.elapsed() / iterations
+}
+
+fn main() {
+    println!(
+        "{:>8}  {:<14} {:>12} {:>12} {:>12}",
+        "tracks", "encoding", "bytes", "serialize", "parse"
+    );
+
+    for count in TRACK_COUNTS {
+        let catalog = Catalog::new(CatalogType::Sesame, &make_tracks(count)).unwrap();
+
+        // Baseline: the pretty-printed JSON previously put on the wire
+        let Catalog::Sesame(sesame) = &catalog else {
+            unreachable!()
+        };
+        let pretty = serde_json::to_vec_pretty(sesame).unwrap();
+        let serialize = measure(|| {
+            black_box(serde_json::to_vec_pretty(black_box(sesame)).unwrap());
+        });
+        let parse = measure(|| {
+            black_box(Catalog::decode_sesame(black_box(&pretty), CatalogEncoding::Json).unwrap());
+        });
+        report(count, "pretty json", pretty.len(), serialize, parse);
+
+        let encoding = CatalogEncoding::Json;
+        let bytes = catalog.encode(encoding).unwrap();
+        let serialize = measure(|| {
+            black_box(catalog.encode(encoding).unwrap());
+        });
+        let parse = measure(|| {
+            black_box(Catalog::decode_sesame(black_box(&bytes), encoding).unwrap());
+        });
+        report(count, "json", bytes.len(), serialize, parse);
+    }
+}
+
+fn report(count: usize, label: &str, bytes: usize, serialize: Duration, parse: Duration) {
+    println!(
+        "{:>8}  {:<14} {:>12} {:>12.1?} {:>12.1?}",
+        count, label, bytes, serialize, parse
+    );
+}
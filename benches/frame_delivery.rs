@@ -0,0 +1,159 @@
+//! Delivery cost per frame of a high-rate track, one callback per frame versus batched
+//!
+//! Run with `cargo bench --bench frame_delivery`. Each callback does what the C API
+//! does per crossing (track name `CString`, metadata conversion, an `extern "C"` call),
+//! so the difference is the amortized FFI overhead. The per-track row is a track's own
+//! callback, which crosses with the track id instead of its name. Uses std timing only.
+
+use moq_wrapper::{
+    DeliveryExecutor, FrameBatching, FrameCallback, FrameInfo, FrameReceivers, ReceivedFrame,
+    TrackFrameCallback,
+};
+use std::ffi::c_void;
+use std::ffi::CString;
+use std::hint::black_box;
+use std::os::raw::c_char;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::Arc;
+use std::time::{Duration, Instant};
+use tokio::sync::RwLock;
+
+const FRAMES: u64 = 200_000;
+const FRAME_SIZE: usize = 64;
+const BATCH_SIZES: [usize; 3] = [8, 64, 256];
+
+static SEEN: AtomicU64 = AtomicU64::new(0);
+
+#[repr(C)]
+struct View {
+    group_sequence: u64,
+    frame_index: u64,
+    arrival_us: u64,
+    data: *const u8,
+    size: usize,
+}
+
+extern "C" fn sink(track: *const c_char, views: *const View, count: usize) {
+    black_box((track, views));
+    SEEN.fetch_add(count as u64, Ordering::Relaxed);
+}
+
+extern "C" fn track_sink(user_data: *mut c_void, view: *const View) {
+    black_box((user_data, view));
+    SEEN.fetch_add(1, Ordering::Relaxed);
+}
+
+fn view(info: &FrameInfo, data: &[u8]) -> View {
+    View {
+        group_sequence: info.group_sequence,
+        frame_index: info.frame_index,
+        arrival_us: info.arrival_micros(),
+        data: data.as_ptr(),
+        size: data.len(),
+    }
+}
+
+fn receivers(frame: Option<FrameCallback>, track: Option<TrackFrameCallback>) -> FrameReceivers {
+    FrameReceivers {
+        data: Arc::new(RwLock::new(None)),
+        frame: Arc::new(RwLock::new(frame)),
+        track: Arc::new(RwLock::new(track)),
+    }
+}
+
+/// Push `FRAMES` frames through a delivery queue and wait until all were delivered
+fn run(
+    runtime: &tokio::runtime::Runtime,
+    batching: Option<FrameBatching>,
+    frame: Option<FrameCallback>,
+    track: Option<TrackFrameCallback>,
+) -> (Duration, u64) {
+    let executor = DeliveryExecutor::new(1);
+    executor.set_batching(batching);
+    let queue = executor.queue("telemetry", receivers(frame, track));
+    let payload = bytes::Bytes::from(vec![0u8; FRAME_SIZE]);
+    SEEN.store(0, Ordering::Relaxed);
+
+    let start = Instant::now();
+    runtime.block_on(async {
+        for index in 0..FRAMES {
+            let info = FrameInfo {
+                track_id: 0,
+                group_sequence: index / 100,
+                frame_index: index % 100,
+                end_of_group: false,
+                arrival: Instant::now(),
+            };
+            queue
+                .push(ReceivedFrame {
+                    info,
+                    data: payload.clone(),
+                })
+                .await;
+        }
+    });
+    while SEEN.load(Ordering::Relaxed) < FRAMES {
+        std::thread::yield_now();
+    }
+    let elapsed = start.elapsed();
+    let calls = executor
+        .stats("telemetry")
+        .map_or(0, |stats| stats.callback_us.count());
+    (elapsed, calls)
+}
+
+fn report(label: &str, elapsed: Duration, calls: u64) {
+    let per_frame = elapsed.as_nanos() as f64 / FRAMES as f64;
+    println!(
+        "{:<16} {:>10.0} {:>12.1} {:>10}",
+        label,
+        FRAMES as f64 / elapsed.as_secs_f64(),
+        per_frame,
+        calls
+    );
+}
+
+fn main() {
+    let runtime = tokio::runtime::Builder::new_multi_thread()
+        .worker_threads(1)
+        .enable_all()
+        .build()
+        .unwrap();
+
+    println!(
+        "{:<16} {:>10} {:>12} {:>10}",
+        "delivery", "frames/s", "ns/frame", "callbacks"
+    );
+
+    let per_frame: FrameCallback = Arc::new(|track, info, data| {
+        let c_track = CString::new(track).unwrap();
+        let view = view(info, data);
+        sink(c_track.as_ptr(), &view, 1);
+    });
+    let (elapsed, calls) = run(&runtime, None, Some(per_frame), None);
+    report("per frame", elapsed, calls);
+
+    let per_track: TrackFrameCallback = Arc::new(|info, data| {
+        let view = view(info, data);
+        track_sink(std::ptr::null_mut(), &view);
+    });
+    let (elapsed, calls) = run(&runtime, None, None, Some(per_track));
+    report("per track", elapsed, calls);
+
+    for max_frames in BATCH_SIZES {
+        let batching = FrameBatching {
+            callback: Arc::new(|track, frames: &[ReceivedFrame]| {
+                let c_track = CString::new(track).unwrap();
+                let views: Vec<View> = frames
+                    .iter()
+                    .map(|frame| view(&frame.info, &frame.data))
+                    .collect();
+                sink(c_track.as_ptr(), views.as_ptr(), views.len());
+            }),
+            max_frames,
+            max_delay: Duration::from_millis(1),
+        };
+        let (elapsed, calls) = run(&runtime, Some(batching), None, None);
+        report(&format!("batch of {}", max_frames), elapsed, calls);
+    }
+}
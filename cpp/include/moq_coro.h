@@ -0,0 +1,392 @@
+#ifndef MOQ_CORO_H
+#define MOQ_CORO_H
+
+// Optional C++20 coroutine layer over moq::Session. The awaitables below suspend
+// without blocking a thread; the library resumes them from its completion callbacks.
+//
+//   auto session = moq::Session::StartPublisher(url, "camera", tracks);
+//   if (!co_await moq::coro::ConnectAsync(*session)) { co_return; }
+//   moq::coro::Writer video(*session, "video");
+//   co_await video.WriteAsync(data, size, true);
+//
+//   auto audio = moq::coro::TrackReader::Subscribe(*subscriber, "audio");
+//   while (true) { moq::coro::Frame frame = co_await audio->NextFrame(); }
+//
+// By default coroutines resume one at a time on a thread this header starts on first use,
+// never on a library thread, so they may call the blocking Session methods and destroy
+// sessions. Set an executor with SetExecutor to resume on your own event loop instead.
+
+#if !defined(__cpp_impl_coroutine) || __cpp_impl_coroutine < 201902L
+#error "moq_coro.h requires C++20 coroutines"
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "moq_wrapper.h"
+
+namespace moq::coro
+{
+  /// Resumes suspended coroutines, for example by posting them to an event loop
+  using Executor = std::function<void(std::coroutine_handle<>)>;
+
+  namespace detail
+  {
+    inline Executor &CurrentExecutor()
+    {
+      static Executor executor;
+      return executor;
+    }
+
+    /// Resumes coroutines in order on a thread of its own, away from the library's threads
+    /// Coroutines still queued when the program exits are not resumed.
+    class ResumeThread
+    {
+    public:
+      ResumeThread() : thread_([this] { Run(); }) {}
+
+      ~ResumeThread()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          stopping_ = true;
+        }
+        ready_.notify_one();
+        thread_.join();
+      }
+
+      void Post(std::coroutine_handle<> handle)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          queue_.push_back(handle);
+        }
+        ready_.notify_one();
+      }
+
+    private:
+      void Run()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+          ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+          if (stopping_)
+          {
+            return;
+          }
+          std::coroutine_handle<> handle = queue_.front();
+          queue_.pop_front();
+          lock.unlock();
+          handle.resume();
+          lock.lock();
+        }
+      }
+
+      std::mutex mutex_;
+      std::condition_variable ready_;
+      std::deque<std::coroutine_handle<>> queue_;
+      bool stopping_ = false;
+      std::thread thread_;
+    };
+
+    inline void Resume(std::coroutine_handle<> handle)
+    {
+      const Executor &executor = CurrentExecutor();
+      if (executor)
+      {
+        executor(handle);
+      }
+      else
+      {
+        static ResumeThread resume_thread;
+        resume_thread.Post(handle);
+      }
+    }
+  } // namespace detail
+
+  /// Resume coroutines through the given executor (empty uses the header's own thread)
+  /// Set it once, before anything is awaited.
+  inline void SetExecutor(Executor executor)
+  {
+    detail::CurrentExecutor() = std::move(executor);
+  }
+
+  /// Awaits a session's connection: true once connected, false if it closed first
+  class ConnectAwaiter
+  {
+  public:
+    explicit ConnectAwaiter(Session &session) : session_(session) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      handle_ = handle;
+      return session_.WhenConnected(&ConnectAwaiter::Done, this);
+    }
+
+    bool await_resume() const noexcept { return connected_; }
+
+  private:
+    static void Done(void *user_data, int result)
+    {
+      auto *self = static_cast<ConnectAwaiter *>(user_data);
+      self->connected_ = result == 0;
+      detail::Resume(self->handle_);
+    }
+
+    Session &session_;
+    std::coroutine_handle<> handle_;
+    bool connected_ = false;
+  };
+
+  /// Awaits the end of a session's connection, resuming with the reason
+  class ClosedAwaiter
+  {
+  public:
+    explicit ClosedAwaiter(Session &session) : session_(session) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      handle_ = handle;
+      return session_.WhenClosed(&ClosedAwaiter::Done, this);
+    }
+
+    std::string await_resume() { return std::move(reason_); }
+
+  private:
+    static void Done(void *user_data, const char *reason)
+    {
+      auto *self = static_cast<ClosedAwaiter *>(user_data);
+      self->reason_ = reason ? reason : "";
+      detail::Resume(self->handle_);
+    }
+
+    Session &session_;
+    std::coroutine_handle<> handle_;
+    std::string reason_;
+  };
+
+  /// Suspend until the session is connected; resumes with false if the connection attempt
+  /// failed, the connection closed first, or the session was closed while connecting
+  /// Works with sessions from Session::StartPublisher and Session::CreateSubscriber.
+  inline ConnectAwaiter ConnectAsync(Session &session)
+  {
+    return ConnectAwaiter(session);
+  }
+
+  /// Suspend until the session's connection closes; resumes with the reason
+  inline ClosedAwaiter Closed(Session &session)
+  {
+    return ClosedAwaiter(session);
+  }
+
+  /// Awaits one frame write, resuming with whether it succeeded
+  class WriteAwaiter
+  {
+  public:
+    WriteAwaiter(Session &session, const std::string &track_name, const uint8_t *data,
+                 size_t size, bool new_group)
+        : session_(session), track_name_(track_name), data_(data), size_(size),
+          new_group_(new_group)
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+      handle_ = handle;
+      return session_.WriteFrameAsync(track_name_, data_, size_, new_group_,
+                                      &WriteAwaiter::Done, this);
+    }
+
+    bool await_resume() const noexcept { return written_; }
+
+  private:
+    static void Done(void *user_data, int result)
+    {
+      auto *self = static_cast<WriteAwaiter *>(user_data);
+      self->written_ = result == 0;
+      detail::Resume(self->handle_);
+    }
+
+    Session &session_;
+    const std::string &track_name_;
+    const uint8_t *data_;
+    size_t size_;
+    bool new_group_;
+    std::coroutine_handle<> handle_;
+    bool written_ = false;
+  };
+
+  /// Writes frames to one track of a publisher session from a coroutine
+  class Writer
+  {
+  public:
+    Writer(Session &session, std::string track_name)
+        : session_(session), track_name_(std::move(track_name))
+    {
+    }
+
+    /// Write a frame; the data is copied before the coroutine suspends
+    /// Each write resumes once the library has taken the frame, so awaiting them one by
+    /// one keeps the track in order.
+    /// @param data Pointer to the data
+    /// @param size Size of the data
+    /// @param new_group If true, starts a new group before writing the frame
+    WriteAwaiter WriteAsync(const uint8_t *data, size_t size, bool new_group = false)
+    {
+      return WriteAwaiter(session_, track_name_, data, size, new_group);
+    }
+
+    WriteAwaiter WriteAsync(const std::vector<uint8_t> &frame, bool new_group = false)
+    {
+      return WriteAsync(frame.data(), frame.size(), new_group);
+    }
+
+    const std::string &track_name() const { return track_name_; }
+
+  private:
+    Session &session_;
+    std::string track_name_;
+  };
+
+  /// A received frame, owned by the coroutine that awaited it
+  struct Frame
+  {
+    /// Session-wide integer id of the track
+    uint32_t track_id;
+    uint64_t group_sequence;
+    uint64_t frame_index;
+    bool end_of_group;
+    std::chrono::steady_clock::time_point arrival;
+    std::vector<uint8_t> data;
+  };
+
+  /// Receives one track's frames by awaiting them one at a time
+  /// Frames arriving while nothing awaits are queued, oldest dropped first once
+  /// max_queued are waiting. One coroutine at a time may await NextFrame.
+  class TrackReader
+  {
+    struct State
+    {
+      std::mutex mutex;
+      std::deque<Frame> frames;
+      size_t max_queued;
+      std::coroutine_handle<> waiter;
+    };
+
+  public:
+    /// Awaits the next frame of the track
+    class NextFrameAwaiter
+    {
+    public:
+      explicit NextFrameAwaiter(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+      bool await_ready() const noexcept { return false; }
+
+      bool await_suspend(std::coroutine_handle<> handle)
+      {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (!state_->frames.empty())
+        {
+          return false;
+        }
+        state_->waiter = handle;
+        return true;
+      }
+
+      Frame await_resume()
+      {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        Frame frame = std::move(state_->frames.front());
+        state_->frames.pop_front();
+        return frame;
+      }
+
+    private:
+      std::shared_ptr<State> state_;
+    };
+
+    /// Subscribe to a track of a subscriber session (see Session::SubscribeTrack)
+    /// Blocks briefly, so call it before suspending or from your own executor.
+    /// @param session The subscriber session
+    /// @param track_name Name of the track
+    /// @param max_queued Most frames kept while nothing awaits
+    /// @return The reader, or nullptr on failure
+    static std::unique_ptr<TrackReader> Subscribe(Session &session,
+                                                  const std::string &track_name,
+                                                  size_t max_queued = 64)
+    {
+      auto state = std::make_shared<State>();
+      state->max_queued = max_queued > 0 ? max_queued : 1;
+      auto subscription = session.SubscribeTrack(
+          track_name, [state](const FrameView &view)
+          { Push(*state, view); });
+      if (!subscription)
+      {
+        return nullptr;
+      }
+      return std::unique_ptr<TrackReader>(
+          new TrackReader(std::move(state), std::move(subscription)));
+    }
+
+    /// Ends the subscription without waiting, so it may go away on any thread
+    ~TrackReader() { TrackSubscription::Release(std::move(subscription_)); }
+
+    TrackReader(const TrackReader &) = delete;
+    TrackReader &operator=(const TrackReader &) = delete;
+
+    /// Suspend until the track's next frame is available
+    NextFrameAwaiter NextFrame() { return NextFrameAwaiter(state_); }
+
+    /// Session-wide integer id of the track
+    uint32_t track_id() const { return subscription_->id(); }
+
+  private:
+    TrackReader(std::shared_ptr<State> state, std::unique_ptr<TrackSubscription> subscription)
+        : state_(std::move(state)), subscription_(std::move(subscription))
+    {
+    }
+
+    static void Push(State &state, const FrameView &view)
+    {
+      std::coroutine_handle<> waiter;
+      {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.frames.size() >= state.max_queued)
+        {
+          state.frames.pop_front();
+        }
+        state.frames.push_back(Frame{view.track_id, view.group_sequence, view.frame_index,
+                                     view.end_of_group, view.arrival,
+                                     std::vector<uint8_t>(view.data, view.data + view.size)});
+        waiter = std::exchange(state.waiter, nullptr);
+      }
+      if (waiter)
+      {
+        detail::Resume(waiter);
+      }
+    }
+
+    std::shared_ptr<State> state_;
+    std::unique_ptr<TrackSubscription> subscription_;
+  };
+
+} // namespace moq::coro
+
+#endif // MOQ_CORO_H
@@ -0,0 +1,215 @@
+#ifndef MOQ_STATIC_BROADCAST_H
+#define MOQ_STATIC_BROADCAST_H
+
+// Optional header-only layer for publishers whose tracks are fixed at compile time:
+//
+//   using Camera = moq::StaticBroadcast<moq::Track<"video", moq::TrackType::kVideo, 10>,
+//                                       moq::Track<"audio", moq::TrackType::kAudio, 20>>;
+//   auto camera = Camera::Create(url, "camera");
+//   auto video = camera->Get<"video">();
+//   video.Write(data, size, keyframe);
+//
+// Track names are resolved to indices at compile time; a name that is not part of the
+// broadcast does not compile. String literals as template arguments need C++20. With
+// C++17, name the track with a constant array instead:
+//
+//   constexpr char kVideo[] = "video";
+//   using Camera = moq::StaticBroadcast<moq::Track<kVideo, moq::TrackType::kVideo, 10>>;
+//   auto video = camera->Get<kVideo>();
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "moq_wrapper.h"
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+#define MOQ_STRING_TEMPLATE_ARGS 1
+#endif
+
+namespace moq
+{
+  namespace detail
+  {
+    constexpr size_t kNoTrack = static_cast<size_t>(-1);
+
+    constexpr const char *NameOf(const char *name) { return name; }
+
+#ifdef MOQ_STRING_TEMPLATE_ARGS
+    /// A string literal usable as a template argument
+    template <size_t N>
+    struct FixedString
+    {
+      char value[N] = {};
+
+      constexpr FixedString(const char (&text)[N])
+      {
+        for (size_t i = 0; i < N; ++i)
+        {
+          value[i] = text[i];
+        }
+      }
+    };
+
+    template <size_t N>
+    constexpr const char *NameOf(const FixedString<N> &name) { return name.value; }
+#endif
+
+    constexpr bool SameName(const char *a, const char *b)
+    {
+      while (*a != '\0' && *a == *b)
+      {
+        ++a;
+        ++b;
+      }
+      return *a == *b;
+    }
+
+    template <typename... Tracks>
+    constexpr size_t IndexOf(const char *name)
+    {
+      constexpr const char *names[] = {Tracks::name...};
+      for (size_t i = 0; i < sizeof...(Tracks); ++i)
+      {
+        if (SameName(names[i], name))
+        {
+          return i;
+        }
+      }
+      return kNoTrack;
+    }
+
+    template <typename... Tracks>
+    constexpr bool UniqueNames()
+    {
+      constexpr const char *names[] = {Tracks::name...};
+      for (size_t i = 0; i < sizeof...(Tracks); ++i)
+      {
+        for (size_t j = i + 1; j < sizeof...(Tracks); ++j)
+        {
+          if (SameName(names[i], names[j]))
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+  } // namespace detail
+
+#ifdef MOQ_STRING_TEMPLATE_ARGS
+#define MOQ_TRACK_NAME detail::FixedString
+#else
+#define MOQ_TRACK_NAME const char *
+#endif
+
+  /// A track of a StaticBroadcast, described entirely by its template arguments
+  template <MOQ_TRACK_NAME Name, TrackType Type, uint32_t Priority = 0>
+  struct Track
+  {
+    static constexpr const char *name = detail::NameOf(Name);
+    static constexpr TrackType track_type = Type;
+    static constexpr uint32_t priority = Priority;
+  };
+
+  /// Writes frames to one track of a StaticBroadcast
+  /// Cheap to copy; valid while the broadcast lives.
+  class TrackWriter
+  {
+  public:
+    /// Write a frame, optionally starting a new group
+    /// @param data Pointer to the data
+    /// @param size Size of the data
+    /// @param new_group If true, starts a new group before writing the frame
+    bool Write(const uint8_t *data, size_t size, bool new_group = false) const
+    {
+      return session_->WriteFrame(name_, data, size, new_group);
+    }
+
+    /// Name of the track
+    const char *name() const { return name_; }
+
+  private:
+    template <typename... Tracks>
+    friend class StaticBroadcast;
+
+    TrackWriter(Session *session, const char *name) : session_(session), name_(name) {}
+
+    Session *session_;
+    const char *name_;
+  };
+
+  /// A publisher broadcast with a set of tracks fixed at compile time
+  /// The track table is built at compile time and converted once when the session is
+  /// created; writers carry the track's static name, so writes involve no lookups or
+  /// strings on this side.
+  template <typename... Tracks>
+  class StaticBroadcast
+  {
+    static_assert(sizeof...(Tracks) > 0, "A broadcast needs at least one track");
+    static_assert(detail::UniqueNames<Tracks...>(), "Track names must be unique");
+
+  public:
+    /// Number of tracks
+    static constexpr size_t kTrackCount = sizeof...(Tracks);
+
+    /// The tracks, in template argument order
+    static constexpr std::array<TrackSpec, sizeof...(Tracks)> kTracks = {
+        {{Tracks::name, Tracks::priority, Tracks::track_type}...}};
+
+    /// Index of the track with the given name; fails to compile for unknown names
+    template <MOQ_TRACK_NAME Name>
+    static constexpr size_t IndexOf()
+    {
+      constexpr size_t index = detail::IndexOf<Tracks...>(detail::NameOf(Name));
+      static_assert(index != detail::kNoTrack, "No track with this name in the broadcast");
+      return index;
+    }
+
+    /// Create the publisher session
+    /// @return The broadcast, or nullptr on failure
+    static std::unique_ptr<StaticBroadcast> Create(const std::string &url,
+                                                   const std::string &broadcast_name,
+                                                   CatalogType catalog_type = CatalogType::kNone)
+    {
+      auto session = Session::CreatePublisher(url, broadcast_name, kTracks.data(),
+                                              kTracks.size(), catalog_type);
+      if (!session)
+      {
+        return nullptr;
+      }
+      return std::unique_ptr<StaticBroadcast>(new StaticBroadcast(std::move(session)));
+    }
+
+    /// Writer of the track with the given name
+    template <MOQ_TRACK_NAME Name>
+    TrackWriter Get() const
+    {
+      return At<IndexOf<Name>()>();
+    }
+
+    /// Writer of the track at the given index
+    template <size_t Index>
+    TrackWriter At() const
+    {
+      static_assert(Index < sizeof...(Tracks), "Track index out of range");
+      return TrackWriter(session_.get(), kTracks[Index].name);
+    }
+
+    /// The underlying session, for starting it, callbacks and group control
+    Session &session() const { return *session_; }
+
+  private:
+    explicit StaticBroadcast(std::unique_ptr<Session> session) : session_(std::move(session)) {}
+
+    std::unique_ptr<Session> session_;
+  };
+
+#undef MOQ_TRACK_NAME
+
+} // namespace moq
+
+#endif // MOQ_STATIC_BROADCAST_H
@@ -1,13 +1,24 @@
 #ifndef MOQ_WRAPPER_H
 #define MOQ_WRAPPER_H
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#define MOQ_HAS_SPAN 1
+#endif
+
 // Windows DLL export/import macros
 #ifdef _WIN32
 #ifdef BUILDING_MOQ_CPP
@@ -51,6 +62,77 @@ namespace moq
     kHang = 2
   };
 
+  /// Where the publisher timestamp (in microseconds) is found in each frame
+  enum class TimestampFormat
+  {
+    /// Leading QUIC variable-length integer, as in the hang container
+    kVarintMicros = 0,
+    /// Leading 8-byte big-endian integer
+    kU64MicrosBigEndian = 1
+  };
+
+  /// Jitter buffer settings for a subscribed track
+  struct JitterBufferConfig
+  {
+    /// Playout delay added on top of the fastest observed transit time
+    std::chrono::milliseconds target_delay{50};
+    /// Upper bound for the adaptive delay
+    std::chrono::milliseconds max_delay{500};
+    /// Grow the delay to three times the measured jitter when that exceeds the target
+    bool adaptive = true;
+    /// Drop frames that arrive after their playout time instead of releasing them at once
+    bool drop_late = false;
+    TimestampFormat timestamp_format = TimestampFormat::kVarintMicros;
+  };
+
+  /// Jitter buffer statistics for a subscribed track
+  struct JitterStats
+  {
+    /// Frames waiting for their playout time
+    size_t occupancy;
+    std::chrono::microseconds delay;
+    std::chrono::microseconds jitter;
+    /// Frames that arrived after their playout time
+    uint64_t late_frames;
+    /// Playout ticks (the expected time of the next frame) at which no frame was due
+    uint64_t underruns;
+    uint64_t released;
+  };
+
+  /// How a subscribed track's frames reach the data callback
+  enum class DeliveryMode
+  {
+    /// Call the callback on the task reading the track (lowest latency)
+    kInline = 0,
+    /// Queue frames for the session's delivery threads, in order
+    kQueued = 1
+  };
+
+  /// What to do with a frame when its track's delivery queue is full
+  enum class OverflowPolicy
+  {
+    /// Wait for room, pushing back on the track's reader
+    kBlock = 0,
+    kDropOldest = 1,
+    kDropNewest = 2
+  };
+
+  /// Delivery statistics for a subscribed track
+  /// Percentiles are upper bounds of power-of-two histogram buckets.
+  struct DeliveryStats
+  {
+    /// Frames handed to the data callback
+    uint64_t delivered;
+    /// Frames dropped by the overflow policy
+    uint64_t dropped;
+    /// Queue depth seen by frames when they were queued
+    uint64_t queue_depth_p50;
+    uint64_t queue_depth_p99;
+    /// Data callback duration
+    std::chrono::microseconds callback_p50;
+    std::chrono::microseconds callback_p99;
+  };
+
   /// Log callback function type
   using LogCallback = std::function<void(const std::string &target, LogLevel level,
                                          const std::string &message)>;
@@ -60,11 +142,202 @@ namespace moq
       std::function<void(const std::string &track, const uint8_t *data,
                          size_t size)>;
 
+  /// A received frame and where it sits in its track
+  /// The data is only valid for the duration of the callback.
+  struct FrameView
+  {
+    /// Session-wide integer id of the track
+    uint32_t track_id;
+    /// Sequence number of the frame's group
+    uint64_t group_sequence;
+    /// Index of the frame within its group; 0 starts a group (a keyframe for video)
+    uint64_t frame_index;
+    /// Last frame of the group, when the group's end was known on arrival
+    bool end_of_group;
+    /// When the frame was fully read
+    std::chrono::steady_clock::time_point arrival;
+    const uint8_t *data;
+    size_t size;
+  };
+
+  /// Frame callback function type
+  using FrameCallback = std::function<void(const std::string &track, const FrameView &frame)>;
+
+  /// Non-owning reference to a callable, called without copying or allocating
+  /// Functions and captureless lambdas are kept by pointer, so temporaries are fine. Any
+  /// other callable is referenced in place and must outlive the FunctionRef.
+  template <typename Signature>
+  class FunctionRef;
+
+  template <typename R, typename... Args>
+  class FunctionRef<R(Args...)>
+  {
+  public:
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                                          std::is_invocable_r_v<R, F &, Args...>>>
+    FunctionRef(F &&callable)
+    {
+      if constexpr (std::is_convertible_v<F, R (*)(Args...)>)
+      {
+        target_.function = callable;
+        invoke_ = &CallFunction;
+      }
+      else
+      {
+        target_.object = const_cast<void *>(static_cast<const void *>(std::addressof(callable)));
+        invoke_ = &CallObject<std::remove_reference_t<F>>;
+      }
+    }
+
+    R operator()(Args... args) const { return invoke_(target_, std::forward<Args>(args)...); }
+
+  private:
+    union Target
+    {
+      void *object;
+      R (*function)(Args...);
+    };
+
+    static R CallFunction(Target target, Args... args)
+    {
+      return target.function(std::forward<Args>(args)...);
+    }
+
+    template <typename F>
+    static R CallObject(Target target, Args... args)
+    {
+      return (*static_cast<F *>(target.object))(std::forward<Args>(args)...);
+    }
+
+    Target target_;
+    R (*invoke_)(Target, Args...);
+  };
+
+  /// Data callback without per-frame allocation: the track name is a view of the
+  /// library's own string and the data is not copied; neither outlives the call
+  using DataViewCallback =
+      FunctionRef<void(std::string_view track, const uint8_t *data, size_t size)>;
+
+  /// Callback of a single subscribed track; frame.track_id identifies the track
+  using TrackFrameCallback = std::function<void(const FrameView &frame)>;
+
+  /// Completes an asynchronous call with its user data and 0 on success, -1 on failure
+  /// Runs on a library thread, where the blocking Session methods must not be called.
+  using CompletionFn = void (*)(void *user_data, int result);
+
+  /// Receives its user data and the reason the session's connection closed
+  using ClosedFn = void (*)(void *user_data, const char *reason);
+
+  /// A piece of a frame of a track in chunked delivery mode
+  /// (group_sequence, frame_index) identifies the frame; the data is only valid for the
+  /// duration of the callback.
+  struct FrameChunk
+  {
+    /// Session-wide integer id of the track
+    uint32_t track_id;
+    uint64_t group_sequence;
+    uint64_t frame_index;
+    /// Size of the whole frame, as announced by the publisher
+    uint64_t frame_size;
+    /// Offset of this chunk within the frame
+    uint64_t offset;
+    /// This chunk completes the frame
+    bool is_last;
+    /// The frame ended or failed short of frame_size; set on a final, empty chunk
+    bool error;
+    const uint8_t *data;
+    size_t size;
+  };
+
+  /// Chunk callback function type
+  using ChunkCallback = std::function<void(const std::string &track, const FrameChunk &chunk)>;
+
+  /// Caller-owned memory a received frame is read into
+  struct MutableBuffer
+  {
+    uint8_t *data;
+    size_t size;
+  };
+
+  /// Buffer provider function type
+  /// Returns memory for a frame of `size` bytes, or {nullptr, 0} to receive the frame
+  /// through the usual callbacks.
+  using BufferProvider = std::function<MutableBuffer(const std::string &track, size_t size)>;
+
+  /// Frame batch callback function type
+  /// Receives `count` consecutive frames of one track, valid for the duration of the callback.
+  using FrameBatchCallback =
+      std::function<void(const std::string &track, const FrameView *frames, size_t count)>;
+
+  /// A frame to publish with Session::WriteFrames
+  /// The data only needs to stay valid until WriteFrames returns.
+  struct FrameSpec
+  {
+    const uint8_t *data;
+    size_t size;
+    /// Close the track's current group and start a new one with this frame
+    bool new_group;
+  };
+
+  /// One part of a frame written with Session::WriteFrameV; laid out like POSIX iovec
+  struct FramePart
+  {
+    const void *data;
+    size_t size;
+  };
+
+  /// Group sequence counters for a subscribed track
+  struct SequenceStats
+  {
+    /// Groups that delivered at least one frame
+    uint64_t groups;
+    /// Sequence numbers skipped over and not (yet) received
+    uint64_t missing_groups;
+    /// Groups that started after a newer group had
+    uint64_t out_of_order_groups;
+    /// Groups whose sequence had already been seen
+    uint64_t duplicate_groups;
+  };
+
   /// Event callback function types
   using BroadcastAnnouncedCallback = std::function<void(const std::string &path)>;
   using BroadcastCancelledCallback = std::function<void(const std::string &path)>;
   using ConnectionClosedCallback = std::function<void(const std::string &reason)>;
 
+  /// Groups skipped callback type; receives the track and how many groups were dropped
+  using GroupsSkippedCallback = std::function<void(const std::string &track, uint64_t count)>;
+
+  class Catalog;
+
+  /// Catalog callback function type; receives the new immutable snapshot
+  using CatalogCallback = std::function<void(std::shared_ptr<const Catalog> catalog)>;
+
+  /// Where a track subscription starts delivering groups
+  /// Chosen among the groups available when the first group arrives; a relay typically
+  /// caches only the newest groups, so Newest() prefill is bounded by what it holds.
+  struct StartPosition
+  {
+    enum class Kind
+    {
+      /// Every group the relay delivers
+      kAny = 0,
+      /// Only the newest available group, then new ones (fastest join for live viewers)
+      kLatest = 1,
+      /// Groups from `value` on; older groups are skipped
+      kGroup = 2,
+      /// The newest `value` available groups, oldest first, then new ones
+      kNewest = 3
+    };
+
+    Kind kind = Kind::kAny;
+    uint64_t value = 0;
+
+    static StartPosition Latest() { return {Kind::kLatest, 0}; }
+    static StartPosition Group(uint64_t sequence) { return {Kind::kGroup, sequence}; }
+    static StartPosition Newest(uint64_t count) { return {Kind::kNewest, count}; }
+  };
+
   /// Track definition
   class MOQ_API TrackDefinition
   {
@@ -85,6 +358,14 @@ namespace moq
     uint32_t priority() const { return priority_; }
     TrackType track_type() const { return track_type_; }
 
+    /// Where subscriptions to this track start (subscribers only)
+    const StartPosition &start_position() const { return start_position_; }
+    TrackDefinition &SetStartPosition(const StartPosition &start_position)
+    {
+      start_position_ = start_position;
+      return *this;
+    }
+
     // Internal handle for FFI
     void *GetHandle() const { return handle_; }
 
@@ -92,14 +373,168 @@ namespace moq
     std::string name_;
     uint32_t priority_;
     TrackType track_type_;
+    StartPosition start_position_;
     void *handle_;
   };
 
+  /// A publisher track whose name outlives the session, such as a string literal
+  /// Literal type, so a fixed set of tracks can be laid out at compile time (see
+  /// moq_static_broadcast.h).
+  struct TrackSpec
+  {
+    const char *name;
+    uint32_t priority;
+    TrackType track_type;
+  };
+
   /// Forward declarations for friend functions
   extern "C" void SessionDataCallbackWrapper(void *, const char *, const uint8_t *, size_t);
   extern "C" void SessionBroadcastAnnouncedWrapper(const char *);
   extern "C" void SessionBroadcastCancelledWrapper(const char *);
   extern "C" void SessionConnectionClosedWrapper(void *, const char *);
+  extern "C" void SessionCatalogCallbackWrapper(void *, void *);
+  extern "C" void SessionGroupsSkippedWrapper(void *, const char *, uint64_t);
+  extern "C" void SessionFrameCallbackWrapper(void *, const char *, const void *, const uint8_t *,
+                                              size_t);
+  extern "C" void SessionDataViewCallbackWrapper(void *, const char *, size_t, const uint8_t *,
+                                                 size_t);
+  extern "C" void SessionFrameBatchCallbackWrapper(void *, const char *, const void *, size_t);
+  extern "C" void TrackSubscriptionFrameWrapper(void *, const void *, const uint8_t *, size_t);
+  extern "C" void SessionChunkCallbackWrapper(void *, const char *, const void *, const uint8_t *,
+                                              size_t);
+  extern "C" uint8_t *SessionProvideBufferWrapper(void *, const char *, uint64_t, size_t *);
+  extern "C" void SessionBufferCompleteWrapper(void *, const char *, const void *, uint8_t *,
+                                               size_t);
+
+  /// Bounds how far a subscribed track may fall behind the live edge
+  /// When a limit is exceeded, queued groups are dropped and reading resumes at the newest.
+  struct LatencyPolicy
+  {
+    /// Maximum time the oldest queued group may wait
+    std::optional<std::chrono::milliseconds> max_latency;
+    /// Maximum number of groups queued behind the one being read
+    std::optional<size_t> max_pending_groups;
+  };
+
+  /// Selects catalog tracks for automatic subscription
+  /// Every criterion that is set must match; unset criteria match anything.
+  struct TrackFilter
+  {
+    std::optional<TrackType> track_type;
+    /// Glob on the track name (`*` any run of characters, `?` one); empty matches all
+    std::string name_glob;
+    /// Only tracks whose priority is at most this value
+    std::optional<uint32_t> max_priority;
+  };
+
+  /// A track listed in a catalog
+  struct CatalogTrack
+  {
+    std::string name;
+    uint32_t priority;
+    TrackType track_type;
+  };
+
+  /// Immutable snapshot of a subscribed broadcast's catalog
+  /// Lookups by name use an index built once per snapshot.
+  class MOQ_API Catalog
+  {
+  public:
+    ~Catalog();
+
+    Catalog(const Catalog &) = delete;
+    Catalog &operator=(const Catalog &) = delete;
+
+    /// Catalog version (increases with every published snapshot group)
+    uint64_t version() const;
+
+    /// Number of tracks in the catalog
+    size_t TrackCount() const;
+
+    /// Track at the given position, in name order
+    /// @param index Position of the track, less than TrackCount()
+    CatalogTrack TrackAt(size_t index) const;
+
+    /// All tracks, sorted by name
+    std::vector<CatalogTrack> Tracks() const;
+
+    /// Look up a track by name
+    /// @param name Name of the track
+    /// @param track If not null, receives the track when found
+    bool FindTrack(const std::string &name, CatalogTrack *track = nullptr) const;
+
+  private:
+    friend class Session;
+    friend void SessionCatalogCallbackWrapper(void *, void *);
+
+    explicit Catalog(void *handle);
+
+    void *handle_;
+  };
+
+  /// A frame being streamed in chunks, created by Session::BeginFrame
+  /// Destroying the writer before Finish() abandons the frame.
+  class MOQ_API FrameWriter
+  {
+  public:
+    ~FrameWriter();
+
+    FrameWriter(const FrameWriter &) = delete;
+    FrameWriter &operator=(const FrameWriter &) = delete;
+
+    /// Send the next chunk of the frame
+    /// Fails if the chunk would exceed the frame's total size.
+    /// @param data Pointer to the chunk
+    /// @param size Size of the chunk
+    bool Append(const uint8_t *data, size_t size);
+
+    /// Complete the frame
+    /// Fails, abandoning the frame, if fewer bytes than its total size were appended.
+    bool Finish();
+
+  private:
+    friend class Session;
+
+    explicit FrameWriter(void *handle);
+
+    void *handle_;
+  };
+
+  /// A track subscribed with its own callback, created by Session::SubscribeTrack
+  /// Destroying it ends the subscription. It must not outlive its session, and must not be
+  /// destroyed from its own callback.
+  class MOQ_API TrackSubscription
+  {
+  public:
+    ~TrackSubscription();
+
+    TrackSubscription(const TrackSubscription &) = delete;
+    TrackSubscription &operator=(const TrackSubscription &) = delete;
+
+    /// Session-wide integer id of the track, carried by every frame as FrameView::track_id
+    uint32_t id() const;
+
+    /// Name of the track
+    const std::string &track_name() const;
+
+    /// End a subscription without waiting for a callback in progress
+    /// The handle is freed once its callback has returned for the last time. Unlike
+    /// destroying it, this may be done from the subscription's own callback.
+    static void Release(std::unique_ptr<TrackSubscription> subscription);
+
+  private:
+    friend class Session;
+    friend void TrackSubscriptionFrameWrapper(void *, const void *, const uint8_t *, size_t);
+
+    TrackSubscription(void *session, const std::string &track_name,
+                      const TrackFrameCallback &callback);
+
+    void *session_;
+    uint32_t id_;
+    bool subscribed_;
+    std::string track_name_;
+    TrackFrameCallback callback_;
+  };
 
   /// MOQ Session wrapper
   class MOQ_API Session
@@ -108,6 +543,18 @@ namespace moq
     friend void SessionBroadcastAnnouncedWrapper(const char *);
     friend void SessionBroadcastCancelledWrapper(const char *);
     friend void SessionConnectionClosedWrapper(void *, const char *);
+    friend void SessionCatalogCallbackWrapper(void *, void *);
+    friend void SessionGroupsSkippedWrapper(void *, const char *, uint64_t);
+    friend void SessionFrameCallbackWrapper(void *, const char *, const void *, const uint8_t *,
+                                            size_t);
+    friend void SessionDataViewCallbackWrapper(void *, const char *, size_t, const uint8_t *,
+                                               size_t);
+    friend void SessionFrameBatchCallbackWrapper(void *, const char *, const void *, size_t);
+    friend void SessionChunkCallbackWrapper(void *, const char *, const void *, const uint8_t *,
+                                            size_t);
+    friend uint8_t *SessionProvideBufferWrapper(void *, const char *, uint64_t, size_t *);
+    friend void SessionBufferCompleteWrapper(void *, const char *, const void *, uint8_t *,
+                                             size_t);
 
   public:
     /// Create a publisher session
@@ -116,6 +563,22 @@ namespace moq
         const std::vector<TrackDefinition> &tracks,
         CatalogType catalog_type = CatalogType::kNone);
 
+    /// Create a publisher session and start connecting, without waiting for the connection
+    /// Unlike CreatePublisher, returns right away; see WhenConnected.
+    static std::unique_ptr<Session> StartPublisher(
+        const std::string &url, const std::string &broadcast_name,
+        const std::vector<TrackDefinition> &tracks,
+        CatalogType catalog_type = CatalogType::kNone);
+
+    /// Create a publisher session from tracks whose names outlive it
+    /// The names are passed through as they are, without copies.
+    /// @param tracks Pointer to the tracks
+    /// @param count Number of tracks
+    static std::unique_ptr<Session> CreatePublisher(
+        const std::string &url, const std::string &broadcast_name,
+        const TrackSpec *tracks, size_t count,
+        CatalogType catalog_type = CatalogType::kNone);
+
     /// Create a subscriber session
     static std::unique_ptr<Session> CreateSubscriber(
         const std::string &url, const std::string &broadcast_name,
@@ -127,6 +590,15 @@ namespace moq
     /// Set data callback for receiving track data
     bool SetDataCallback(const DataCallback &callback);
 
+    /// Set data callback that allocates nothing per frame, unlike SetDataCallback
+    /// The callback is referenced, not copied: a capturing lambda or functor must stay
+    /// alive until ClearDataViewCallback or the session's destruction. Runs alongside the
+    /// frame callback, on the same thread.
+    bool SetDataViewCallback(DataViewCallback callback);
+
+    /// Stop calling the data view callback
+    bool ClearDataViewCallback();
+
     /// Set log callback for receiving session-specific log messages
     bool SetLogCallback(const LogCallback &callback);
 
@@ -139,6 +611,128 @@ namespace moq
     /// Set callback for when connection is closed
     bool SetConnectionClosedCallback(const ConnectionClosedCallback &callback);
 
+    /// Set callback for when the subscribed catalog changes
+    /// Fires immediately if a catalog has already been received. The callback may call back
+    /// into the session, including SetCatalogCallback to replace itself.
+    bool SetCatalogCallback(const CatalogCallback &callback);
+
+    /// Set callback for when groups of a track are skipped to catch up with the live edge
+    bool SetGroupsSkippedCallback(const GroupsSkippedCallback &callback);
+
+    /// Set callback receiving every subscribed frame with its group sequence, index within
+    /// the group, end-of-group flag, arrival time and track id
+    /// Runs alongside the data callback, on the same thread and in the same order.
+    bool SetFrameCallback(const FrameCallback &callback);
+
+    /// Subscribe to a track and deliver its frames to a callback of its own
+    /// The track name is resolved once, here: frames reach the callback with the track's
+    /// integer id and no name, and without going through the session's callback lookup.
+    /// Runs alongside the data and frame callbacks. Tracks not requested at creation or
+    /// picked by a filter stay subscribed until the handle is destroyed. A track takes one
+    /// such subscription at a time.
+    /// @param track_name Name of the track
+    /// @param callback Callback to invoke with each frame
+    /// @return The subscription, or nullptr on failure
+    std::unique_ptr<TrackSubscription> SubscribeTrack(const std::string &track_name,
+                                                      const TrackFrameCallback &callback);
+
+    /// Set callback receiving a track's ready frames in batches, one call per batch
+    /// A batch is delivered once max_frames frames are queued or the oldest has waited
+    /// max_delay; a zero delay delivers whatever is ready. Cuts the per-frame cost of
+    /// high-rate tracks. Runs alongside the data and frame callbacks; batches form on tracks
+    /// queued with SetDeliveryMode, inline tracks hand over one frame at a time.
+    /// @param callback Callback to invoke with each batch
+    /// @param max_frames Most frames per batch
+    /// @param max_delay Longest a frame waits for its batch to fill
+    bool SetFrameBatchCallback(const FrameBatchCallback &callback, size_t max_frames = 64,
+                               std::chrono::microseconds max_delay = std::chrono::milliseconds(1));
+
+    /// Go back to per-frame delivery
+    bool ClearFrameBatchCallback();
+
+    /// Set callback receiving the frames of chunked tracks piece by piece as they arrive
+    /// See SetChunkedDelivery.
+    bool SetChunkCallback(const ChunkCallback &callback);
+
+    /// Deliver a track chunk by chunk to the chunk callback, before each frame fully arrives
+    /// Large objects can be parsed or written out as they land and are never assembled in
+    /// memory. The data and frame callbacks, jitter buffer and delivery queue are bypassed
+    /// for the track, and its groups are read one at a time so chunks arrive in order. A
+    /// frame cut short ends with an empty chunk flagged error. A running subscription of the
+    /// track is restarted to switch modes.
+    /// @param track_name Name of the track
+    /// @param enabled Whether to deliver the track in chunks
+    bool SetChunkedDelivery(const std::string &track_name, bool enabled = true);
+
+    /// Read received frames straight into caller-provided memory
+    /// Each frame is copied exactly once, into the buffer the provider returns for it, and
+    /// is then passed to on_complete with its metadata; frame.data points into that buffer
+    /// and frame.size is the number of bytes written. Every buffer comes back: a frame cut
+    /// short, or abandoned by unsubscribe, pause or restart, completes with fewer bytes than
+    /// requested, and a buffer smaller than requested completes empty while the frame goes
+    /// to the usual callbacks. Both callbacks run on the thread reading the track, bypassing
+    /// the jitter buffer and delivery queue. Chunked tracks are not affected.
+    /// @param provider Returns a buffer of at least the requested size, or {nullptr, 0}
+    /// @param on_complete Receives each filled buffer back
+    bool SetBufferProvider(const BufferProvider &provider, const FrameCallback &on_complete);
+
+    /// Receive frames through the usual callbacks again
+    bool ClearBufferProvider();
+
+    /// Get the group sequence counters of a track
+    /// @param track_name Name of the track
+    /// @param stats Receives the counters
+    bool GetSequenceStats(const std::string &track_name, SequenceStats *stats) const;
+
+    /// Bound how far a subscribed track may fall behind the live edge
+    /// @param track_name Name of the track
+    /// @param policy Limits to apply; a policy with no limits removes the bound
+    bool SetLatencyPolicy(const std::string &track_name, const LatencyPolicy &policy);
+
+    /// Release a track's frames on a steady clock through a jitter buffer
+    /// Frames are timed by the publisher timestamp they carry (see TimestampFormat).
+    /// @param track_name Name of the track
+    /// @param config Jitter buffer settings
+    bool SetJitterBuffer(const std::string &track_name, const JitterBufferConfig &config);
+
+    /// Deliver a track's frames as soon as they arrive again
+    bool ClearJitterBuffer(const std::string &track_name);
+
+    /// Get the jitter buffer statistics of a track
+    /// @param track_name Name of the track
+    /// @param stats Receives the statistics
+    bool GetJitterStats(const std::string &track_name, JitterStats *stats) const;
+
+    /// Choose how a track's frames reach the data callback
+    /// By default the callback runs on the task reading the track. Queuing a track starts
+    /// dedicated delivery threads, so a slow callback only holds back its own track.
+    /// @param track_name Name of the track
+    /// @param mode Inline or queued delivery
+    /// @param capacity Frames the queue holds before the overflow policy applies
+    /// @param overflow What to do with frames when the queue is full
+    bool SetDeliveryMode(const std::string &track_name, DeliveryMode mode, size_t capacity = 256,
+                         OverflowPolicy overflow = OverflowPolicy::kBlock);
+
+    /// Get the delivery statistics of a track
+    /// @param track_name Name of the track
+    /// @param stats Receives the statistics
+    bool GetDeliveryStats(const std::string &track_name, DeliveryStats *stats) const;
+
+    /// Subscribe to every catalog track matching any of the filters
+    /// Subscriptions follow the catalog: new matches are subscribed and removed tracks
+    /// unsubscribed. Requires a catalog type; an empty list clears the filters.
+    /// @param filters Filters to match catalog tracks against
+    bool SetTrackFilters(const std::vector<TrackFilter> &filters);
+
+    /// Get the latest catalog received by this subscriber
+    /// @return Immutable snapshot, or nullptr if no catalog has been received yet
+    std::shared_ptr<const Catalog> GetCatalog() const;
+
+    /// Get how long a track took from subscribe request to its first group
+    /// @param track_name Name of the track
+    /// @param elapsed Receives the time; left unchanged if the track has no data yet
+    bool GetSubscribeTime(const std::string &track_name, std::chrono::microseconds *elapsed) const;
+
     /// Write a frame to a track, optionally starting a new group
     /// @param track_name Name of the track
     /// @param data Pointer to the data
@@ -147,6 +741,61 @@ namespace moq
     bool WriteFrame(const std::string &track_name, const uint8_t *data,
                     size_t size, bool new_group = false);
 
+    /// Write a frame to a track named by a C string, optionally starting a new group
+    /// Same as above without building a std::string per call.
+    bool WriteFrame(const char *track_name, const uint8_t *data, size_t size,
+                    bool new_group = false);
+
+    /// Write a frame to a track named by a string view, optionally starting a new group
+    /// The name is passed with its length, so it need not be NUL-terminated.
+    bool WriteFrame(std::string_view track_name, const uint8_t *data, size_t size,
+                    bool new_group = false);
+
+#ifdef MOQ_HAS_SPAN
+    /// Write a frame held in any contiguous byte range, optionally starting a new group
+    bool WriteFrame(std::string_view track_name, std::span<const uint8_t> data,
+                    bool new_group = false)
+    {
+      return WriteFrame(track_name, data.data(), data.size(), new_group);
+    }
+#endif
+
+    /// Write one frame gathered from several parts, such as a header and a payload
+    /// The parts are copied once into the frame, so they never need joining first.
+    /// @param track_name Name of the track
+    /// @param parts Parts of the frame, in order
+    /// @param count Number of parts
+    /// @param new_group If true, starts a new group before writing the frame
+    bool WriteFrameV(const std::string &track_name, const FramePart *parts, size_t count,
+                     bool new_group = false);
+
+    /// Write one frame gathered from several parts, e.g. WriteFrameV("video", {header, payload})
+    bool WriteFrameV(const std::string &track_name, std::initializer_list<FramePart> parts,
+                     bool new_group = false);
+
+    /// Start a frame of a known size to be streamed in chunks
+    /// Each chunk goes out as it is appended, so very large frames need not be buffered
+    /// whole before sending. Frames written to the track before it finishes follow it.
+    /// @param track_name Name of the track
+    /// @param total_size Size of the whole frame in bytes
+    /// @param new_group If true, starts a new group with this frame
+    /// @return The writer, or nullptr on failure
+    std::unique_ptr<FrameWriter> BeginFrame(const std::string &track_name, uint64_t total_size,
+                                            bool new_group = false);
+
+    /// Write a run of frames to a track in one call
+    /// Cheaper than one WriteFrame per frame for many small frames. If the session is not
+    /// connected nothing is written; a later failure leaves the earlier frames written.
+    /// @param track_name Name of the track
+    /// @param frames Frames to write, in order
+    /// @param count Number of frames
+    bool WriteFrames(const std::string &track_name, const FrameSpec *frames, size_t count);
+
+    /// Write a run of frames to a track in one call
+    /// @param track_name Name of the track
+    /// @param frames Frames to write, in order
+    bool WriteFrames(const std::string &track_name, const std::vector<FrameSpec> &frames);
+
     /// Write a single frame in its own group (convenience method)
     /// Creates a new group, writes the frame, and closes the group
     bool WriteSingleFrame(const std::string &track_name, const uint8_t *data, size_t size);
@@ -157,12 +806,58 @@ namespace moq
     /// @param size Size of the data
     bool PublishData(const std::string &track_name, const uint8_t *data, size_t size);
 
+    /// Add a track to a live publisher session
+    /// Creates the track producer and republishes the catalog without reconnecting
+    /// @param track Definition of the track to add
+    bool AddTrack(const TrackDefinition &track);
+
+    /// Remove a track from a live publisher session
+    /// Closes the track producer and republishes the catalog without reconnecting
+    /// @param track_name Name of the track to remove
+    bool RemoveTrack(const std::string &track_name);
+
+    /// Stop receiving a subscribed track, e.g. while it is not displayed
+    /// The publisher stops sending it; settings and statistics are kept for a fast
+    /// resume, and the pause survives reconnects.
+    /// @param track_name Name of the track to pause
+    bool PauseTrack(const std::string &track_name);
+
+    /// Subscribe again to a paused track, with its original priority and start position
+    /// @param track_name Name of the track to resume
+    bool ResumeTrack(const std::string &track_name);
+
     /// Check if session is connected
     bool IsConnected() const;
 
     /// Close the session
     bool Close();
 
+    /// Call done once the session is connected, without blocking
+    /// Completes right away if it already is, and with -1 if the connection attempt fails,
+    /// the connection closes first, or the session is closed while connecting. Sessions
+    /// connect once, so -1 is final. Never called if the session is destroyed while waiting.
+    /// @param done Completion function
+    /// @param user_data Passed to done; must stay valid until it runs
+    bool WhenConnected(CompletionFn done, void *user_data);
+
+    /// Call done with the reason once the session's connection closes, without blocking
+    /// Never called if the session is destroyed while waiting.
+    /// @param done Function receiving the reason, valid only during the call
+    /// @param user_data Passed to done; must stay valid until it runs
+    bool WhenClosed(ClosedFn done, void *user_data);
+
+    /// Write a frame without blocking, and report the outcome to done
+    /// The data is copied before this returns. Writes in flight together may land in any
+    /// order; start the next one from done to keep them in sequence.
+    /// @param track_name Name of the track
+    /// @param data Pointer to the data
+    /// @param size Size of the data
+    /// @param new_group If true, starts a new group before writing the frame
+    /// @param done Completion function
+    /// @param user_data Passed to done; must stay valid until it runs
+    bool WriteFrameAsync(const std::string &track_name, const uint8_t *data, size_t size,
+                         bool new_group, CompletionFn done, void *user_data);
+
   private:
     explicit Session(void *handle);
 
@@ -172,6 +867,15 @@ namespace moq
     std::unique_ptr<BroadcastAnnouncedCallback> broadcast_announced_callback_;
     std::unique_ptr<BroadcastCancelledCallback> broadcast_cancelled_callback_;
     std::unique_ptr<ConnectionClosedCallback> connection_closed_callback_;
+    // Shared so a running callback survives being replaced from inside itself
+    std::shared_ptr<CatalogCallback> catalog_callback_;
+    std::unique_ptr<GroupsSkippedCallback> groups_skipped_callback_;
+    std::unique_ptr<FrameCallback> frame_callback_;
+    std::unique_ptr<DataViewCallback> data_view_callback_;
+    std::unique_ptr<FrameBatchCallback> frame_batch_callback_;
+    std::unique_ptr<ChunkCallback> chunk_callback_;
+    std::unique_ptr<BufferProvider> buffer_provider_;
+    std::unique_ptr<FrameCallback> buffer_complete_callback_;
   };
 
   /// Set the global log level for internal library tracing (optional)
@@ -1,10 +1,12 @@
 #include "moq_wrapper.h"
 
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <map>
 #include <mutex>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
 
 // C-compatible track definition structure
@@ -13,8 +15,101 @@ struct TrackDefinitionFFI
   const char *name;
   uint32_t priority;
   uint8_t track_type;
+  uint8_t start_mode;
+  uint64_t start_value;
 };
 
+// C-compatible catalog track; name is not NUL-terminated and is owned by the catalog
+struct CatalogTrackFFI
+{
+  const char *name;
+  size_t name_len;
+  uint32_t priority;
+  uint8_t track_type;
+};
+
+// C-compatible jitter buffer settings and statistics
+struct JitterConfigFFI
+{
+  uint32_t target_delay_ms;
+  uint32_t max_delay_ms;
+  uint8_t adaptive;
+  uint8_t drop_late;
+  uint8_t timestamp_format;
+};
+
+struct JitterStatsFFI
+{
+  size_t occupancy;
+  uint64_t delay_us;
+  uint64_t jitter_us;
+  uint64_t late_frames;
+  uint64_t underruns;
+  uint64_t released;
+};
+
+// C-compatible frame metadata and group sequence counters
+struct FrameInfoFFI
+{
+  uint32_t track_id;
+  uint64_t group_sequence;
+  uint64_t frame_index;
+  uint8_t end_of_group;
+  uint64_t arrival_us;
+};
+
+struct FrameChunkFFI
+{
+  uint32_t track_id;
+  uint64_t group_sequence;
+  uint64_t frame_index;
+  uint64_t frame_size;
+  uint64_t offset;
+  uint8_t is_last;
+  uint8_t error;
+};
+
+struct FrameViewFFI
+{
+  FrameInfoFFI info;
+  const uint8_t *data;
+  size_t size;
+};
+
+struct SequenceStatsFFI
+{
+  uint64_t groups;
+  uint64_t missing_groups;
+  uint64_t out_of_order_groups;
+  uint64_t duplicate_groups;
+};
+
+// C-compatible delivery statistics
+struct DeliveryStatsFFI
+{
+  uint64_t delivered;
+  uint64_t dropped;
+  uint64_t queue_depth_p50;
+  uint64_t queue_depth_p99;
+  uint64_t callback_p50_us;
+  uint64_t callback_p99_us;
+};
+
+// C-compatible track filter; negative or null fields match anything
+struct TrackFilterFFI
+{
+  int track_type;
+  const char *name_glob;
+  int64_t max_priority;
+};
+
+// moq::FrameSpec and moq::FramePart are passed straight through to C; keep the layouts in step
+static_assert(std::is_standard_layout<moq::FrameSpec>::value, "FrameSpec must be a C struct");
+static_assert(offsetof(moq::FrameSpec, size) == sizeof(const uint8_t *), "FrameSpec layout");
+static_assert(sizeof(bool) == 1, "FrameSpec::new_group must match a C bool");
+static_assert(sizeof(moq::FramePart) == sizeof(const void *) + sizeof(size_t),
+              "FramePart layout");
+
 // Forward declarations for C FFI functions
 extern "C"
 {
@@ -31,15 +126,87 @@ extern "C"
                              const uint8_t *data, size_t data_len);
   int moq_write_frame(void *session, const char *track_name,
                       const uint8_t *data, size_t data_len, int new_group);
+  int moq_write_frame_n(void *session, const char *track_name, size_t track_name_len,
+                        const uint8_t *data, size_t data_len, bool new_group);
   int moq_publish_data(void *session, const char *track_name,
                        const uint8_t *data, size_t data_len);
+  int moq_write_frames(void *session, const char *track_name,
+                       const moq::FrameSpec *frames, size_t count);
+  int moq_write_frame_parts(void *session, const char *track_name,
+                            const moq::FramePart *parts, size_t count, bool new_group);
+  void *moq_frame_writer_begin(void *session, const char *track_name, uint64_t total_size,
+                               bool new_group);
+  int moq_frame_writer_append(void *writer, const uint8_t *data, size_t data_len);
+  int moq_frame_writer_finish(void *writer);
+  void moq_frame_writer_free(void *writer);
+  int moq_add_track(void *session, const char *name, uint32_t priority, uint8_t track_type);
+  int moq_remove_track(void *session, const char *track_name);
+  int moq_session_pause_track(void *session, const char *track_name);
+  int moq_session_resume_track(void *session, const char *track_name);
   int moq_is_connected(void *session);
+  void *moq_start_publisher(const char *url, const char *broadcast_name,
+                            const TrackDefinitionFFI *tracks, size_t track_count,
+                            int catalog_type);
+  int moq_session_when_connected(void *session, void (*callback)(void *, int), void *user_data);
+  int moq_session_when_closed(void *session, void (*callback)(void *, const char *),
+                              void *user_data);
+  int moq_write_frame_async(void *session, const char *track_name, const uint8_t *data,
+                            size_t data_len, bool new_group, void (*callback)(void *, int),
+                            void *user_data);
+  int moq_session_unsubscribe_track_async(void *session, uint32_t track_id,
+                                          void (*callback)(void *, int), void *user_data);
   int moq_close_session(void *session);
   void moq_session_free(void *session);
   int moq_session_set_log_callback(void *session, void (*callback)(const char *, int, const char *));
   int moq_session_set_broadcast_announced_callback(void *session, void (*callback)(const char *));
   int moq_session_set_broadcast_cancelled_callback(void *session, void (*callback)(const char *));
   int moq_session_set_connection_closed_callback(void *session, void (*callback)(void *, const char *));
+  int moq_session_set_catalog_callback(void *session, void (*callback)(void *, void *));
+  int moq_session_set_groups_skipped_callback(void *session,
+                                              void (*callback)(void *, const char *, uint64_t));
+  int moq_session_set_frame_callback(void *session,
+                                     void (*callback)(void *, const char *, const void *,
+                                                      const uint8_t *, size_t));
+  int moq_session_set_data_view_callback(void *session,
+                                         void (*callback)(void *, const char *, size_t,
+                                                          const uint8_t *, size_t));
+  int moq_session_subscribe_track(void *session, const char *track_name,
+                                  void (*callback)(void *, const void *, const uint8_t *, size_t),
+                                  void *user_data, uint32_t *out_id);
+  int moq_session_unsubscribe_track(void *session, uint32_t track_id);
+  int moq_session_set_frame_batch_callback(void *session,
+                                           void (*callback)(void *, const char *, const void *,
+                                                            size_t),
+                                           size_t max_frames, uint64_t max_delay_us);
+  int moq_session_set_chunk_callback(void *session,
+                                     void (*callback)(void *, const char *, const void *,
+                                                      const uint8_t *, size_t));
+  int moq_session_set_chunked_delivery(void *session, const char *track_name, bool enabled);
+  int moq_session_set_buffer_provider(void *session,
+                                      uint8_t *(*provide)(void *, const char *, uint64_t,
+                                                          size_t *),
+                                      void (*complete)(void *, const char *, const void *,
+                                                       uint8_t *, size_t));
+  uint64_t moq_monotonic_time_us();
+  int moq_session_get_sequence_stats(void *session, const char *track_name,
+                                     SequenceStatsFFI *stats);
+  int moq_session_set_latency_policy(void *session, const char *track_name,
+                                     int64_t max_latency_ms, int64_t max_pending_groups);
+  void *moq_session_get_catalog(void *session);
+  int moq_session_get_subscribe_time(void *session, const char *track_name, uint64_t *elapsed_us);
+  int moq_session_set_jitter_buffer(void *session, const char *track_name,
+                                    const JitterConfigFFI *config);
+  int moq_session_get_jitter_stats(void *session, const char *track_name, JitterStatsFFI *stats);
+  int moq_session_set_delivery_mode(void *session, const char *track_name, int mode,
+                                    size_t capacity, int overflow);
+  int moq_session_get_delivery_stats(void *session, const char *track_name,
+                                     DeliveryStatsFFI *stats);
+  int moq_session_set_track_filters(void *session, const TrackFilterFFI *filters, size_t filter_count);
+  uint64_t moq_catalog_version(const void *catalog);
+  size_t moq_catalog_track_count(const void *catalog);
+  int moq_catalog_track_at(const void *catalog, size_t index, CatalogTrackFFI *out);
+  int moq_catalog_find_track(const void *catalog, const char *track_name, CatalogTrackFFI *out);
+  void moq_catalog_free(void *catalog);
 }
 
 namespace moq
@@ -84,6 +251,12 @@ namespace moq
       (void)size;
     }
 
+    CatalogTrack ToCatalogTrack(const CatalogTrackFFI &track)
+    {
+      return CatalogTrack{std::string(track.name, track.name_len), track.priority,
+                          static_cast<TrackType>(track.track_type)};
+    }
+
   } // namespace
 
   // C wrapper functions for new callbacks - outside anonymous namespace to access globals
@@ -156,7 +329,8 @@ namespace moq
 
   // Copy constructor - creates a new Rust handle
   TrackDefinition::TrackDefinition(const TrackDefinition &other)
-      : name_(other.name_), priority_(other.priority_), track_type_(other.track_type_)
+      : name_(other.name_), priority_(other.priority_), track_type_(other.track_type_),
+        start_position_(other.start_position_)
   {
     // Create a new Rust handle for the copy
     handle_ = moq_track_definition_new(name_.c_str(), priority_,
@@ -178,6 +352,7 @@ namespace moq
       name_ = other.name_;
       priority_ = other.priority_;
       track_type_ = other.track_type_;
+      start_position_ = other.start_position_;
 
       // Create new Rust handle
       handle_ = moq_track_definition_new(name_.c_str(), priority_,
@@ -189,7 +364,8 @@ namespace moq
   // Move constructor - transfers ownership of Rust handle
   TrackDefinition::TrackDefinition(TrackDefinition &&other) noexcept
       : name_(std::move(other.name_)), priority_(other.priority_),
-        track_type_(other.track_type_), handle_(other.handle_)
+        track_type_(other.track_type_), start_position_(other.start_position_),
+        handle_(other.handle_)
   {
     // Take ownership of handle
     other.handle_ = nullptr;
@@ -210,6 +386,7 @@ namespace moq
       name_ = std::move(other.name_);
       priority_ = other.priority_;
       track_type_ = other.track_type_;
+      start_position_ = other.start_position_;
       handle_ = other.handle_;
 
       // Take ownership
@@ -218,6 +395,62 @@ namespace moq
     return *this;
   }
 
+  Catalog::Catalog(void *handle) : handle_(handle) {}
+
+  Catalog::~Catalog()
+  {
+    if (handle_)
+    {
+      moq_catalog_free(handle_);
+    }
+  }
+
+  uint64_t Catalog::version() const
+  {
+    return moq_catalog_version(handle_);
+  }
+
+  size_t Catalog::TrackCount() const
+  {
+    return moq_catalog_track_count(handle_);
+  }
+
+  CatalogTrack Catalog::TrackAt(size_t index) const
+  {
+    CatalogTrackFFI track{};
+    if (moq_catalog_track_at(handle_, index, &track) != 0)
+    {
+      return CatalogTrack{std::string(), 0, TrackType::kData};
+    }
+    return ToCatalogTrack(track);
+  }
+
+  std::vector<CatalogTrack> Catalog::Tracks() const
+  {
+    size_t count = TrackCount();
+    std::vector<CatalogTrack> tracks;
+    tracks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      tracks.push_back(TrackAt(i));
+    }
+    return tracks;
+  }
+
+  bool Catalog::FindTrack(const std::string &name, CatalogTrack *track) const
+  {
+    CatalogTrackFFI found{};
+    if (moq_catalog_find_track(handle_, name.c_str(), &found) != 0)
+    {
+      return false;
+    }
+    if (track)
+    {
+      *track = ToCatalogTrack(found);
+    }
+    return true;
+  }
+
   void SetLogLevel(LogLevel log_level)
   {
     // Set global tracing level for internal library diagnostics
@@ -240,7 +473,73 @@ namespace moq
       track_names.push_back(track.name());
       ffi_tracks.push_back({track_names.back().c_str(),
                             track.priority(),
-                            static_cast<uint8_t>(track.track_type())});
+                            static_cast<uint8_t>(track.track_type()),
+                            static_cast<uint8_t>(track.start_position().kind),
+                            track.start_position().value});
+    }
+
+    void *handle = moq_create_publisher(
+        url.c_str(), broadcast_name.c_str(),
+        ffi_tracks.empty() ? nullptr : ffi_tracks.data(),
+        ffi_tracks.size(), static_cast<int>(catalog_type));
+
+    if (!handle)
+    {
+      return nullptr;
+    }
+
+    return std::unique_ptr<Session>(new Session(handle));
+  }
+
+  std::unique_ptr<Session> Session::StartPublisher(
+      const std::string &url, const std::string &broadcast_name,
+      const std::vector<TrackDefinition> &tracks, CatalogType catalog_type)
+  {
+    // The names point into `tracks`, which outlives the call
+    std::vector<TrackDefinitionFFI> ffi_tracks;
+    ffi_tracks.reserve(tracks.size());
+    for (const auto &track : tracks)
+    {
+      ffi_tracks.push_back({track.name().c_str(),
+                            track.priority(),
+                            static_cast<uint8_t>(track.track_type()),
+                            static_cast<uint8_t>(track.start_position().kind),
+                            track.start_position().value});
+    }
+
+    void *handle = moq_start_publisher(
+        url.c_str(), broadcast_name.c_str(),
+        ffi_tracks.empty() ? nullptr : ffi_tracks.data(),
+        ffi_tracks.size(), static_cast<int>(catalog_type));
+
+    if (!handle)
+    {
+      return nullptr;
+    }
+
+    return std::unique_ptr<Session>(new Session(handle));
+  }
+
+  std::unique_ptr<Session> Session::CreatePublisher(const std::string &url,
+                                                    const std::string &broadcast_name,
+                                                    const TrackSpec *tracks, size_t count,
+                                                    CatalogType catalog_type)
+  {
+    if (!tracks && count > 0)
+    {
+      return nullptr;
+    }
+
+    // The names are borrowed; the session copies them on creation
+    std::vector<TrackDefinitionFFI> ffi_tracks;
+    ffi_tracks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      ffi_tracks.push_back({tracks[i].name,
+                            tracks[i].priority,
+                            static_cast<uint8_t>(tracks[i].track_type),
+                            static_cast<uint8_t>(StartPosition::Kind::kAny),
+                            0});
     }
 
     void *handle = moq_create_publisher(
@@ -272,7 +571,9 @@ namespace moq
       track_names.push_back(track.name());
       ffi_tracks.push_back({track_names.back().c_str(),
                             track.priority(),
-                            static_cast<uint8_t>(track.track_type())});
+                            static_cast<uint8_t>(track.track_type()),
+                            static_cast<uint8_t>(track.start_position().kind),
+                            track.start_position().value});
     }
 
     void *handle = moq_create_subscriber(
@@ -309,6 +610,14 @@ namespace moq
         broadcast_announced_callback_.reset();
         broadcast_cancelled_callback_.reset();
         connection_closed_callback_.reset();
+        catalog_callback_.reset();
+        groups_skipped_callback_.reset();
+        frame_callback_.reset();
+        data_view_callback_.reset();
+        frame_batch_callback_.reset();
+        chunk_callback_.reset();
+        buffer_provider_.reset();
+        buffer_complete_callback_.reset();
       }
 
       // Unregister from session map and clear global pointer if it's this session
@@ -458,51 +767,1009 @@ namespace moq
     return moq_session_set_connection_closed_callback(handle_, SessionConnectionClosedWrapper) == 0;
   }
 
-  bool Session::WriteFrame(const std::string &track_name, const uint8_t *data,
-                           size_t size, bool new_group)
+  // Session-specific catalog callback wrapper; takes ownership of the catalog handle
+  extern "C" void SessionCatalogCallbackWrapper(void *ffi_session_ptr, void *catalog_handle)
   {
-    if (!handle_)
+    std::shared_ptr<const Catalog> catalog(new Catalog(catalog_handle));
+    if (!ffi_session_ptr)
+      return;
+
+    Session *session = nullptr;
     {
-      return false;
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
     }
 
-    return moq_write_frame(handle_, track_name.c_str(), data, size, new_group ? 1 : 0) == 0;
+    std::shared_ptr<CatalogCallback> callback;
+    if (session)
+    {
+      std::lock_guard<std::mutex> lock(session->callback_mutex_);
+      callback = session->catalog_callback_;
+    }
+
+    if (callback)
+    {
+      try
+      {
+        (*callback)(catalog);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in catalog callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in catalog callback" << std::endl;
+      }
+    }
   }
 
-  bool Session::WriteSingleFrame(const std::string &track_name, const uint8_t *data, size_t size)
+  bool Session::SetCatalogCallback(const CatalogCallback &callback)
   {
     if (!handle_)
     {
       return false;
     }
-    return moq_write_single_frame(handle_, track_name.c_str(), data, size) == 0;
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      catalog_callback_ = std::make_shared<CatalogCallback>(callback);
+    }
+
+    // Set the callback in the Rust session
+    return moq_session_set_catalog_callback(handle_, SessionCatalogCallbackWrapper) == 0;
   }
 
-  bool Session::PublishData(const std::string &track_name, const uint8_t *data, size_t size)
+  // Session-specific groups skipped callback wrapper
+  extern "C" void SessionGroupsSkippedWrapper(void *ffi_session_ptr, const char *track, uint64_t count)
+  {
+    if (!ffi_session_ptr)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->groups_skipped_callback_)
+    {
+      try
+      {
+        (*session->groups_skipped_callback_)(std::string(track), count);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in groups skipped callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in groups skipped callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetGroupsSkippedCallback(const GroupsSkippedCallback &callback)
   {
     if (!handle_)
     {
       return false;
     }
-    return moq_publish_data(handle_, track_name.c_str(), data, size) == 0;
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      groups_skipped_callback_ = std::make_unique<GroupsSkippedCallback>(callback);
+    }
+
+    // Set the callback in the Rust session
+    return moq_session_set_groups_skipped_callback(handle_, SessionGroupsSkippedWrapper) == 0;
   }
 
-  bool Session::IsConnected() const
+  // Session-specific frame callback wrapper
+  extern "C" void SessionFrameCallbackWrapper(void *ffi_session_ptr, const char *track,
+                                              const void *info, const uint8_t *data, size_t size)
+  {
+    if (!ffi_session_ptr || !info)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->frame_callback_)
+    {
+      const auto *ffi_info = static_cast<const FrameInfoFFI *>(info);
+      // Map the library's monotonic clock onto steady_clock
+      uint64_t age_us = moq_monotonic_time_us() - ffi_info->arrival_us;
+
+      FrameView frame;
+      frame.track_id = ffi_info->track_id;
+      frame.group_sequence = ffi_info->group_sequence;
+      frame.frame_index = ffi_info->frame_index;
+      frame.end_of_group = ffi_info->end_of_group != 0;
+      frame.arrival = std::chrono::steady_clock::now() - std::chrono::microseconds(age_us);
+      frame.data = data;
+      frame.size = size;
+      try
+      {
+        (*session->frame_callback_)(std::string(track), frame);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in frame callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in frame callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetFrameCallback(const FrameCallback &callback)
   {
     if (!handle_)
     {
       return false;
     }
-    return moq_is_connected(handle_) != 0;
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      frame_callback_ = std::make_unique<FrameCallback>(callback);
+    }
+
+    // Set the callback in the Rust session
+    return moq_session_set_frame_callback(handle_, SessionFrameCallbackWrapper) == 0;
   }
 
-  bool Session::Close()
+  // Session-specific data view callback wrapper; the track name is not NUL-terminated
+  extern "C" void SessionDataViewCallbackWrapper(void *ffi_session_ptr, const char *track,
+                                                 size_t track_len, const uint8_t *data,
+                                                 size_t size)
+  {
+    if (!ffi_session_ptr)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->data_view_callback_)
+    {
+      try
+      {
+        (*session->data_view_callback_)(std::string_view(track, track_len), data, size);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in data view callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in data view callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetDataViewCallback(DataViewCallback callback)
   {
     if (!handle_)
     {
       return false;
     }
-    return moq_close_session(handle_) == 0;
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      data_view_callback_ = std::make_unique<DataViewCallback>(callback);
+    }
+
+    // Set the callback in the Rust session
+    return moq_session_set_data_view_callback(handle_, SessionDataViewCallbackWrapper) == 0;
+  }
+
+  bool Session::ClearDataViewCallback()
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    if (moq_session_set_data_view_callback(handle_, nullptr) != 0)
+    {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    data_view_callback_.reset();
+    return true;
+  }
+
+  // Per-track frame callback wrapper; the user data is the subscription itself
+  extern "C" void TrackSubscriptionFrameWrapper(void *user_data, const void *info,
+                                                const uint8_t *data, size_t size)
+  {
+    if (!user_data || !info)
+      return;
+
+    auto *subscription = static_cast<TrackSubscription *>(user_data);
+    const auto *ffi_info = static_cast<const FrameInfoFFI *>(info);
+    // Map the library's monotonic clock onto steady_clock
+    uint64_t age_us = moq_monotonic_time_us() - ffi_info->arrival_us;
+
+    FrameView frame;
+    frame.track_id = ffi_info->track_id;
+    frame.group_sequence = ffi_info->group_sequence;
+    frame.frame_index = ffi_info->frame_index;
+    frame.end_of_group = ffi_info->end_of_group != 0;
+    frame.arrival = std::chrono::steady_clock::now() - std::chrono::microseconds(age_us);
+    frame.data = data;
+    frame.size = size;
+    try
+    {
+      subscription->callback_(frame);
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << "Exception in track callback: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+      std::cerr << "Unknown exception in track callback" << std::endl;
+    }
+  }
+
+  // Completion of TrackSubscription::Release
+  extern "C" void TrackSubscriptionReleasedWrapper(void *user_data, int)
+  {
+    delete static_cast<TrackSubscription *>(user_data);
+  }
+
+  std::unique_ptr<TrackSubscription> Session::SubscribeTrack(const std::string &track_name,
+                                                             const TrackFrameCallback &callback)
+  {
+    if (!handle_ || !callback)
+    {
+      return nullptr;
+    }
+
+    // Created first: its address is the user data the first frame arrives with
+    std::unique_ptr<TrackSubscription> subscription(
+        new TrackSubscription(handle_, track_name, callback));
+    if (moq_session_subscribe_track(handle_, track_name.c_str(), TrackSubscriptionFrameWrapper,
+                                    subscription.get(), &subscription->id_) != 0)
+    {
+      return nullptr;
+    }
+    subscription->subscribed_ = true;
+    return subscription;
+  }
+
+  TrackSubscription::TrackSubscription(void *session, const std::string &track_name,
+                                       const TrackFrameCallback &callback)
+      : session_(session), id_(0), subscribed_(false), track_name_(track_name),
+        callback_(callback)
+  {
+  }
+
+  TrackSubscription::~TrackSubscription()
+  {
+    // Waits for a callback in progress
+    if (subscribed_)
+    {
+      moq_session_unsubscribe_track(session_, id_);
+    }
+  }
+
+  uint32_t TrackSubscription::id() const
+  {
+    return id_;
+  }
+
+  const std::string &TrackSubscription::track_name() const
+  {
+    return track_name_;
+  }
+
+  void TrackSubscription::Release(std::unique_ptr<TrackSubscription> subscription)
+  {
+    if (!subscription || !subscription->subscribed_)
+    {
+      return;
+    }
+
+    // Freed once the last callback has returned
+    TrackSubscription *released = subscription.release();
+    released->subscribed_ = false;
+    if (moq_session_unsubscribe_track_async(released->session_, released->id_,
+                                            TrackSubscriptionReleasedWrapper, released) != 0)
+    {
+      delete released;
+    }
+  }
+
+  // Session-specific frame batch callback wrapper
+  extern "C" void SessionFrameBatchCallbackWrapper(void *ffi_session_ptr, const char *track,
+                                                   const void *frames, size_t count)
+  {
+    if (!ffi_session_ptr || !frames)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->frame_batch_callback_)
+    {
+      const auto *ffi_frames = static_cast<const FrameViewFFI *>(frames);
+      // Map the library's monotonic clock onto steady_clock once per batch
+      uint64_t now_us = moq_monotonic_time_us();
+      auto now = std::chrono::steady_clock::now();
+
+      // Reused across batches on each delivery thread
+      thread_local std::vector<FrameView> views;
+      views.resize(count);
+      for (size_t i = 0; i < count; ++i)
+      {
+        const FrameViewFFI &ffi_frame = ffi_frames[i];
+        FrameView &frame = views[i];
+        frame.track_id = ffi_frame.info.track_id;
+        frame.group_sequence = ffi_frame.info.group_sequence;
+        frame.frame_index = ffi_frame.info.frame_index;
+        frame.end_of_group = ffi_frame.info.end_of_group != 0;
+        frame.arrival = now - std::chrono::microseconds(now_us - ffi_frame.info.arrival_us);
+        frame.data = ffi_frame.data;
+        frame.size = ffi_frame.size;
+      }
+      try
+      {
+        (*session->frame_batch_callback_)(std::string(track), views.data(), count);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in frame batch callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in frame batch callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetFrameBatchCallback(const FrameBatchCallback &callback, size_t max_frames,
+                                      std::chrono::microseconds max_delay)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      frame_batch_callback_ = std::make_unique<FrameBatchCallback>(callback);
+    }
+
+    uint64_t max_delay_us = max_delay.count() > 0 ? static_cast<uint64_t>(max_delay.count()) : 0;
+    return moq_session_set_frame_batch_callback(handle_, SessionFrameBatchCallbackWrapper,
+                                                max_frames, max_delay_us) == 0;
+  }
+
+  bool Session::ClearFrameBatchCallback()
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    if (moq_session_set_frame_batch_callback(handle_, nullptr, 0, 0) != 0)
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    frame_batch_callback_.reset();
+    return true;
+  }
+
+  // Session-specific chunk callback wrapper
+  extern "C" void SessionChunkCallbackWrapper(void *ffi_session_ptr, const char *track,
+                                              const void *info, const uint8_t *data, size_t size)
+  {
+    if (!ffi_session_ptr || !info)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->chunk_callback_)
+    {
+      const auto *ffi_chunk = static_cast<const FrameChunkFFI *>(info);
+      FrameChunk chunk;
+      chunk.track_id = ffi_chunk->track_id;
+      chunk.group_sequence = ffi_chunk->group_sequence;
+      chunk.frame_index = ffi_chunk->frame_index;
+      chunk.frame_size = ffi_chunk->frame_size;
+      chunk.offset = ffi_chunk->offset;
+      chunk.is_last = ffi_chunk->is_last != 0;
+      chunk.error = ffi_chunk->error != 0;
+      chunk.data = data;
+      chunk.size = size;
+      try
+      {
+        (*session->chunk_callback_)(std::string(track), chunk);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in chunk callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in chunk callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetChunkCallback(const ChunkCallback &callback)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    // Store the callback in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      chunk_callback_ = std::make_unique<ChunkCallback>(callback);
+    }
+
+    // Set the callback in the Rust session
+    return moq_session_set_chunk_callback(handle_, SessionChunkCallbackWrapper) == 0;
+  }
+
+  bool Session::SetChunkedDelivery(const std::string &track_name, bool enabled)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_session_set_chunked_delivery(handle_, track_name.c_str(), enabled) == 0;
+  }
+
+  // Session-specific buffer provider wrapper
+  extern "C" uint8_t *SessionProvideBufferWrapper(void *ffi_session_ptr, const char *track,
+                                                  uint64_t size, size_t *capacity)
+  {
+    if (!ffi_session_ptr || !capacity)
+      return nullptr;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->buffer_provider_)
+    {
+      try
+      {
+        MutableBuffer buffer = (*session->buffer_provider_)(std::string(track),
+                                                            static_cast<size_t>(size));
+        *capacity = buffer.size;
+        return buffer.data;
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in buffer provider: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in buffer provider" << std::endl;
+      }
+    }
+    return nullptr;
+  }
+
+  // Session-specific buffer completion wrapper
+  extern "C" void SessionBufferCompleteWrapper(void *ffi_session_ptr, const char *track,
+                                               const void *info, uint8_t *data, size_t size)
+  {
+    if (!ffi_session_ptr || !info)
+      return;
+
+    Session *session = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(g_session_map_mutex);
+      auto it = g_session_map.find(ffi_session_ptr);
+      if (it != g_session_map.end())
+      {
+        session = it->second;
+      }
+    }
+
+    if (session && session->buffer_complete_callback_)
+    {
+      const auto *ffi_info = static_cast<const FrameInfoFFI *>(info);
+      // Map the library's monotonic clock onto steady_clock
+      uint64_t age_us = moq_monotonic_time_us() - ffi_info->arrival_us;
+
+      FrameView frame;
+      frame.track_id = ffi_info->track_id;
+      frame.group_sequence = ffi_info->group_sequence;
+      frame.frame_index = ffi_info->frame_index;
+      frame.end_of_group = ffi_info->end_of_group != 0;
+      frame.arrival = std::chrono::steady_clock::now() - std::chrono::microseconds(age_us);
+      frame.data = data;
+      frame.size = size;
+      try
+      {
+        (*session->buffer_complete_callback_)(std::string(track), frame);
+      }
+      catch (const std::exception &e)
+      {
+        std::cerr << "Exception in buffer completion callback: " << e.what() << std::endl;
+      }
+      catch (...)
+      {
+        std::cerr << "Unknown exception in buffer completion callback" << std::endl;
+      }
+    }
+  }
+
+  bool Session::SetBufferProvider(const BufferProvider &provider,
+                                  const FrameCallback &on_complete)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    // Store the callbacks in this session instance
+    {
+      std::lock_guard<std::mutex> lock(callback_mutex_);
+      buffer_provider_ = std::make_unique<BufferProvider>(provider);
+      buffer_complete_callback_ = std::make_unique<FrameCallback>(on_complete);
+    }
+
+    // Set the callbacks in the Rust session
+    return moq_session_set_buffer_provider(handle_, SessionProvideBufferWrapper,
+                                           SessionBufferCompleteWrapper) == 0;
+  }
+
+  bool Session::ClearBufferProvider()
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    // Buffers already handed out still come back to the completion callback, so keep it
+    if (moq_session_set_buffer_provider(handle_, nullptr, nullptr) != 0)
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    buffer_provider_.reset();
+    return true;
+  }
+
+  bool Session::GetSequenceStats(const std::string &track_name, SequenceStats *stats) const
+  {
+    if (!handle_ || !stats)
+    {
+      return false;
+    }
+
+    SequenceStatsFFI ffi_stats;
+    if (moq_session_get_sequence_stats(handle_, track_name.c_str(), &ffi_stats) != 0)
+    {
+      return false;
+    }
+    stats->groups = ffi_stats.groups;
+    stats->missing_groups = ffi_stats.missing_groups;
+    stats->out_of_order_groups = ffi_stats.out_of_order_groups;
+    stats->duplicate_groups = ffi_stats.duplicate_groups;
+    return true;
+  }
+
+  bool Session::SetLatencyPolicy(const std::string &track_name, const LatencyPolicy &policy)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    int64_t max_latency_ms = policy.max_latency ? policy.max_latency->count() : -1;
+    int64_t max_pending_groups =
+        policy.max_pending_groups ? static_cast<int64_t>(*policy.max_pending_groups) : -1;
+    return moq_session_set_latency_policy(handle_, track_name.c_str(), max_latency_ms,
+                                          max_pending_groups) == 0;
+  }
+
+  bool Session::SetJitterBuffer(const std::string &track_name, const JitterBufferConfig &config)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    JitterConfigFFI ffi_config;
+    ffi_config.target_delay_ms = static_cast<uint32_t>(config.target_delay.count());
+    ffi_config.max_delay_ms = static_cast<uint32_t>(config.max_delay.count());
+    ffi_config.adaptive = config.adaptive ? 1 : 0;
+    ffi_config.drop_late = config.drop_late ? 1 : 0;
+    ffi_config.timestamp_format = static_cast<uint8_t>(config.timestamp_format);
+    return moq_session_set_jitter_buffer(handle_, track_name.c_str(), &ffi_config) == 0;
+  }
+
+  bool Session::ClearJitterBuffer(const std::string &track_name)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    return moq_session_set_jitter_buffer(handle_, track_name.c_str(), nullptr) == 0;
+  }
+
+  bool Session::GetJitterStats(const std::string &track_name, JitterStats *stats) const
+  {
+    if (!handle_ || !stats)
+    {
+      return false;
+    }
+
+    JitterStatsFFI ffi_stats;
+    if (moq_session_get_jitter_stats(handle_, track_name.c_str(), &ffi_stats) != 0)
+    {
+      return false;
+    }
+    stats->occupancy = ffi_stats.occupancy;
+    stats->delay = std::chrono::microseconds(ffi_stats.delay_us);
+    stats->jitter = std::chrono::microseconds(ffi_stats.jitter_us);
+    stats->late_frames = ffi_stats.late_frames;
+    stats->underruns = ffi_stats.underruns;
+    stats->released = ffi_stats.released;
+    return true;
+  }
+
+  bool Session::SetDeliveryMode(const std::string &track_name, DeliveryMode mode, size_t capacity,
+                                OverflowPolicy overflow)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    return moq_session_set_delivery_mode(handle_, track_name.c_str(), static_cast<int>(mode),
+                                         capacity, static_cast<int>(overflow)) == 0;
+  }
+
+  bool Session::GetDeliveryStats(const std::string &track_name, DeliveryStats *stats) const
+  {
+    if (!handle_ || !stats)
+    {
+      return false;
+    }
+
+    DeliveryStatsFFI ffi_stats;
+    if (moq_session_get_delivery_stats(handle_, track_name.c_str(), &ffi_stats) != 0)
+    {
+      return false;
+    }
+    stats->delivered = ffi_stats.delivered;
+    stats->dropped = ffi_stats.dropped;
+    stats->queue_depth_p50 = ffi_stats.queue_depth_p50;
+    stats->queue_depth_p99 = ffi_stats.queue_depth_p99;
+    stats->callback_p50 = std::chrono::microseconds(ffi_stats.callback_p50_us);
+    stats->callback_p99 = std::chrono::microseconds(ffi_stats.callback_p99_us);
+    return true;
+  }
+
+  bool Session::SetTrackFilters(const std::vector<TrackFilter> &filters)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    std::vector<TrackFilterFFI> ffi_filters;
+    ffi_filters.reserve(filters.size());
+    for (const auto &filter : filters)
+    {
+      TrackFilterFFI ffi_filter;
+      ffi_filter.track_type = filter.track_type ? static_cast<int>(*filter.track_type) : -1;
+      ffi_filter.name_glob = filter.name_glob.empty() ? nullptr : filter.name_glob.c_str();
+      ffi_filter.max_priority = filter.max_priority ? static_cast<int64_t>(*filter.max_priority) : -1;
+      ffi_filters.push_back(ffi_filter);
+    }
+
+    return moq_session_set_track_filters(handle_,
+                                         ffi_filters.empty() ? nullptr : ffi_filters.data(),
+                                         ffi_filters.size()) == 0;
+  }
+
+  std::shared_ptr<const Catalog> Session::GetCatalog() const
+  {
+    if (!handle_)
+    {
+      return nullptr;
+    }
+
+    void *catalog = moq_session_get_catalog(handle_);
+    if (!catalog)
+    {
+      return nullptr;
+    }
+    return std::shared_ptr<const Catalog>(new Catalog(catalog));
+  }
+
+  bool Session::GetSubscribeTime(const std::string &track_name,
+                                 std::chrono::microseconds *elapsed) const
+  {
+    if (!handle_ || !elapsed)
+    {
+      return false;
+    }
+
+    uint64_t elapsed_us = 0;
+    if (moq_session_get_subscribe_time(handle_, track_name.c_str(), &elapsed_us) != 0)
+    {
+      return false;
+    }
+    *elapsed = std::chrono::microseconds(elapsed_us);
+    return true;
+  }
+
+  bool Session::WriteFrame(const std::string &track_name, const uint8_t *data,
+                           size_t size, bool new_group)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    return moq_write_frame(handle_, track_name.c_str(), data, size, new_group ? 1 : 0) == 0;
+  }
+
+  bool Session::WriteFrame(const char *track_name, const uint8_t *data, size_t size,
+                           bool new_group)
+  {
+    if (!handle_ || !track_name)
+    {
+      return false;
+    }
+
+    return moq_write_frame(handle_, track_name, data, size, new_group ? 1 : 0) == 0;
+  }
+
+  bool Session::WriteFrame(std::string_view track_name, const uint8_t *data, size_t size,
+                           bool new_group)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+
+    return moq_write_frame_n(handle_, track_name.data(), track_name.size(), data, size,
+                             new_group) == 0;
+  }
+
+  bool Session::WriteFrameV(const std::string &track_name, const FramePart *parts, size_t count,
+                            bool new_group)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_write_frame_parts(handle_, track_name.c_str(), parts, count, new_group) == 0;
+  }
+
+  bool Session::WriteFrameV(const std::string &track_name, std::initializer_list<FramePart> parts,
+                            bool new_group)
+  {
+    return WriteFrameV(track_name, parts.begin(), parts.size(), new_group);
+  }
+
+  FrameWriter::FrameWriter(void *handle) : handle_(handle) {}
+
+  FrameWriter::~FrameWriter()
+  {
+    if (handle_)
+    {
+      moq_frame_writer_free(handle_);
+    }
+  }
+
+  bool FrameWriter::Append(const uint8_t *data, size_t size)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_frame_writer_append(handle_, data, size) == 0;
+  }
+
+  bool FrameWriter::Finish()
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    // The writer is released either way
+    void *handle = handle_;
+    handle_ = nullptr;
+    return moq_frame_writer_finish(handle) == 0;
+  }
+
+  std::unique_ptr<FrameWriter> Session::BeginFrame(const std::string &track_name,
+                                                   uint64_t total_size, bool new_group)
+  {
+    if (!handle_)
+    {
+      return nullptr;
+    }
+
+    void *writer = moq_frame_writer_begin(handle_, track_name.c_str(), total_size, new_group);
+    if (!writer)
+    {
+      return nullptr;
+    }
+    return std::unique_ptr<FrameWriter>(new FrameWriter(writer));
+  }
+
+  bool Session::WriteFrames(const std::string &track_name, const FrameSpec *frames, size_t count)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_write_frames(handle_, track_name.c_str(), frames, count) == 0;
+  }
+
+  bool Session::WriteFrames(const std::string &track_name, const std::vector<FrameSpec> &frames)
+  {
+    return WriteFrames(track_name, frames.data(), frames.size());
+  }
+
+  bool Session::WriteSingleFrame(const std::string &track_name, const uint8_t *data, size_t size)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_write_single_frame(handle_, track_name.c_str(), data, size) == 0;
+  }
+
+  bool Session::PublishData(const std::string &track_name, const uint8_t *data, size_t size)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_publish_data(handle_, track_name.c_str(), data, size) == 0;
+  }
+
+  bool Session::AddTrack(const TrackDefinition &track)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_add_track(handle_, track.name().c_str(), track.priority(),
+                         static_cast<uint8_t>(track.track_type())) == 0;
+  }
+
+  bool Session::RemoveTrack(const std::string &track_name)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_remove_track(handle_, track_name.c_str()) == 0;
+  }
+
+  bool Session::PauseTrack(const std::string &track_name)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_session_pause_track(handle_, track_name.c_str()) == 0;
+  }
+
+  bool Session::ResumeTrack(const std::string &track_name)
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_session_resume_track(handle_, track_name.c_str()) == 0;
+  }
+
+  bool Session::IsConnected() const
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_is_connected(handle_) != 0;
+  }
+
+  bool Session::Close()
+  {
+    if (!handle_)
+    {
+      return false;
+    }
+    return moq_close_session(handle_) == 0;
+  }
+
+  bool Session::WhenConnected(CompletionFn done, void *user_data)
+  {
+    if (!handle_ || !done)
+    {
+      return false;
+    }
+    return moq_session_when_connected(handle_, done, user_data) == 0;
+  }
+
+  bool Session::WhenClosed(ClosedFn done, void *user_data)
+  {
+    if (!handle_ || !done)
+    {
+      return false;
+    }
+    return moq_session_when_closed(handle_, done, user_data) == 0;
+  }
+
+  bool Session::WriteFrameAsync(const std::string &track_name, const uint8_t *data, size_t size,
+                                bool new_group, CompletionFn done, void *user_data)
+  {
+    if (!handle_ || !done)
+    {
+      return false;
+    }
+    return moq_write_frame_async(handle_, track_name.c_str(), data, size, new_group, done,
+                                 user_data) == 0;
   }
 
 } // namespace moq
\ No newline at end of file
@@ -113,12 +113,14 @@ async fn run_subscriber(args: Args) -> Result<()> {
         name: track_name.clone(),
         priority: 0,
         track_type: TrackType::Video,
+        start: Default::default(),
     };
 
     let track_def2 = TrackDefinition {
         name: "audio".to_string(),
         priority: 0,
         track_type: TrackType::Audio,
+        start: Default::default(),
     };
 
     let tracks = vec![track_def, track_def2];
@@ -1,5 +1,7 @@
+use bytes::Bytes;
 use serde::{Deserialize, Serialize};
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
+use std::sync::{Arc, OnceLock};
 
 #[derive(Clone, Debug, PartialEq, Eq, Serialize, Deserialize)]
 pub enum TrackType {
@@ -21,12 +23,32 @@ impl std::fmt::Display for TrackType {
     }
 }
 
-#[derive(Clone, Debug, Serialize, Deserialize)]
+/// Where a track subscription starts delivering groups
+///
+/// Chosen among the groups available when the first group arrives; a relay typically
+/// caches only the newest groups, so `Newest` prefill is bounded by what it holds.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum StartPosition {
+    /// Every group the relay delivers
+    #[default]
+    Any,
+    /// Only the newest available group, then new ones (fastest join for live viewers)
+    Latest,
+    /// Groups from this sequence on; older groups are skipped
+    Group(u64),
+    /// The newest N available groups, oldest first, then new ones
+    Newest(usize),
+}
+
+#[derive(Clone, Debug, PartialEq, Eq, Serialize, Deserialize)]
 pub struct TrackDefinition {
     pub name: String,
     pub priority: u32,
     #[serde(rename = "type")]
     pub track_type: TrackType,
+    /// Where subscriptions to this track start (subscribers only; not part of catalogs)
+    #[serde(skip)]
+    pub start: StartPosition,
 }
 
 impl TrackDefinition {
@@ -35,9 +57,15 @@ impl TrackDefinition {
             name: name.into(),
             priority,
             track_type,
+            start: StartPosition::Any,
         }
     }
 
+    pub fn with_start(mut self, start: StartPosition) -> Self {
+        self.start = start;
+        self
+    }
+
     pub fn video(name: impl Into<String>, priority: u32) -> Self {
         Self::new(name, priority, TrackType::Video)
     }
@@ -60,6 +88,87 @@ impl From<TrackDefinition> for moq_lite::Track {
     }
 }
 
+/// Selects catalog tracks for automatic subscription
+///
+/// Every criterion that is set must match; unset criteria match anything. A subscriber
+/// with several filters subscribes to tracks matching any of them.
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct TrackFilter {
+    pub track_type: Option<TrackType>,
+    /// Glob on the track name: `*` matches any run of characters, `?` exactly one
+    pub name_glob: Option<String>,
+    /// Only tracks whose priority is at most this value
+    pub max_priority: Option<u32>,
+}
+
+impl TrackFilter {
+    /// Filter matching every track
+    pub fn any() -> Self {
+        Self::default()
+    }
+
+    pub fn with_type(mut self, track_type: TrackType) -> Self {
+        self.track_type = Some(track_type);
+        self
+    }
+
+    pub fn with_name_glob(mut self, glob: impl Into<String>) -> Self {
+        self.name_glob = Some(glob.into());
+        self
+    }
+
+    pub fn with_max_priority(mut self, max_priority: u32) -> Self {
+        self.max_priority = Some(max_priority);
+        self
+    }
+
+    pub fn matches(&self, track: &TrackDefinition) -> bool {
+        self.track_type
+            .as_ref()
+            .is_none_or(|track_type| *track_type == track.track_type)
+            && self
+                .max_priority
+                .is_none_or(|max_priority| track.priority <= max_priority)
+            && self
+                .name_glob
+                .as_deref()
+                .is_none_or(|glob| glob_match(glob, &track.name))
+    }
+}
+
+/// Match `name` against a glob supporting `*` and `?`
+fn glob_match(pattern: &str, name: &str) -> bool {
+    let pattern: Vec<char> = pattern.chars().collect();
+    let name: Vec<char> = name.chars().collect();
+    let (mut p, mut n) = (0, 0);
+    // Position of the last `*` and the name position it was tried against
+    let mut backtrack: Option<(usize, usize)> = None;
+
+    while n < name.len() {
+        match pattern.get(p) {
+            Some('*') => {
+                backtrack = Some((p, n));
+                p += 1;
+            }
+            Some(&c) if c == '?' || c == name[n] => {
+                p += 1;
+                n += 1;
+            }
+            _ => match backtrack {
+                // Let the last `*` absorb one more character
+                Some((star, star_n)) => {
+                    backtrack = Some((star, star_n + 1));
+                    p = star + 1;
+                    n = star_n + 1;
+                }
+                None => return false,
+            },
+        }
+    }
+
+    pattern[p..].iter().all(|&c| c == '*')
+}
+
 #[derive(Clone, Debug, PartialEq, Eq)]
 pub enum CatalogType {
     None,
@@ -67,6 +176,55 @@ pub enum CatalogType {
     Hang,
 }
 
+impl CatalogType {
+    /// Wire encoding used for catalog.json frames of this type
+    pub fn encoding(&self) -> CatalogEncoding {
+        CatalogEncoding::Json
+    }
+
+    /// Whether catalog changes may be sent as delta frames after a group's snapshot
+    ///
+    /// Hang players only read the snapshot that starts each group, so Hang catalogs get a
+    /// new snapshot group for every change.
+    pub fn supports_deltas(&self) -> bool {
+        matches!(self, CatalogType::Sesame)
+    }
+}
+
+/// Failure to encode or decode a catalog document
+#[derive(Debug, thiserror::Error)]
+pub enum CatalogError {
+    #[error("JSON: {0}")]
+    Json(#[from] serde_json::Error),
+
+    #[error("no catalog type configured for this session")]
+    NoCatalogType,
+}
+
+/// Serialization format of catalog snapshots and deltas on the wire
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum CatalogEncoding {
+    /// Compact (whitespace-free) JSON
+    Json,
+}
+
+impl CatalogEncoding {
+    /// Serialize any catalog document in this encoding
+    pub fn encode<T: Serialize>(&self, value: &T) -> Result<Bytes, CatalogError> {
+        let bytes = match self {
+            CatalogEncoding::Json => serde_json::to_vec(value)?,
+        };
+        Ok(Bytes::from(bytes))
+    }
+
+    /// Parse a catalog document previously produced by `encode`
+    pub fn decode<T: serde::de::DeserializeOwned>(&self, bytes: &[u8]) -> Result<T, CatalogError> {
+        Ok(match self {
+            CatalogEncoding::Json => serde_json::from_slice(bytes)?,
+        })
+    }
+}
+
 /// Sesame format catalog (TypeScript-compatible)
 #[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct SesameCatalog {
@@ -100,7 +258,7 @@ impl SesameCatalog {
     }
 
     pub fn to_json(&self) -> Result<String, serde_json::Error> {
-        serde_json::to_string_pretty(self)
+        serde_json::to_string(self)
     }
 
     pub fn from_json(json: &str) -> Result<Self, serde_json::Error> {
@@ -110,6 +268,21 @@ impl SesameCatalog {
     pub fn find_track(&self, name: &str) -> Option<&SesameCatalogTrack> {
         self.tracks.iter().find(|t| t.track_name == name)
     }
+
+    /// Add a track, replacing any existing entry with the same name
+    pub fn add_track(&mut self, def: &TrackDefinition) {
+        match self.tracks.iter_mut().find(|t| t.track_name == def.name) {
+            Some(existing) => *existing = def.into(),
+            None => self.tracks.push(def.into()),
+        }
+    }
+
+    /// Remove a track by name, returning true if it was present
+    pub fn remove_track(&mut self, name: &str) -> bool {
+        let before = self.tracks.len();
+        self.tracks.retain(|t| t.track_name != name);
+        self.tracks.len() != before
+    }
 }
 
 /// Hang format catalog (JSON-based, compatible with hang crate)
@@ -312,20 +485,7 @@ impl HangCatalog {
                 TrackType::Video => {
                     // Create a basic video rendition
                     let mut renditions = HashMap::new();
-                    renditions.insert(
-                        track.name.clone(),
-                        HangVideoConfig {
-                            codec: "avc1.42001e".to_string(), // H.264 baseline profile
-                            description: None,
-                            coded_width: Some(1280),
-                            coded_height: Some(720),
-                            display_ratio_width: None,
-                            display_ratio_height: None,
-                            bitrate: Some(2_000_000), // 2 Mbps default
-                            framerate: Some(30.0),
-                            optimize_for_latency: Some(true),
-                        },
-                    );
+                    renditions.insert(track.name.clone(), default_video_config());
 
                     catalog.video = Some(HangVideo {
                         renditions,
@@ -338,16 +498,7 @@ impl HangCatalog {
                 TrackType::Audio => {
                     // Create a basic audio rendition
                     let mut renditions = HashMap::new();
-                    renditions.insert(
-                        track.name.clone(),
-                        HangAudioConfig {
-                            codec: "opus".to_string(),
-                            sample_rate: 48000,
-                            channel_count: 2,
-                            bitrate: Some(128_000), // 128 kbps default
-                            description: None,
-                        },
-                    );
+                    renditions.insert(track.name.clone(), default_audio_config());
 
                     catalog.audio = Some(HangAudio {
                         renditions,
@@ -410,9 +561,9 @@ impl HangCatalog {
         false
     }
 
-    /// Serialize to JSON string
+    /// Serialize to compact JSON string
     pub fn to_json(&self) -> Result<String, serde_json::Error> {
-        serde_json::to_string_pretty(self)
+        serde_json::to_string(self)
     }
 
     /// Parse from JSON string
@@ -442,6 +593,198 @@ impl HangCatalog {
 
         audio.renditions.insert(name, config);
     }
+
+    /// Add a track using the same defaults as `from_tracks`
+    ///
+    /// Video and audio tracks become additional renditions; data tracks replace the preview.
+    pub fn add_track(&mut self, track: &TrackDefinition) {
+        let priority = track.priority as u8;
+        match track.track_type {
+            TrackType::Video => {
+                self.add_video_track(track.name.clone(), default_video_config(), priority)
+            }
+            TrackType::Audio => {
+                self.add_audio_track(track.name.clone(), default_audio_config(), priority)
+            }
+            TrackType::Data => {
+                if track.name != "catalog.json" {
+                    self.preview = Some(HangTrack {
+                        name: track.name.clone(),
+                        priority,
+                    });
+                }
+            }
+        }
+    }
+
+    /// Remove a track by name, returning true if it was present
+    ///
+    /// Video and audio sections are dropped once their last rendition is removed.
+    pub fn remove_track(&mut self, name: &str) -> bool {
+        let mut removed = false;
+
+        if let Some(video) = &mut self.video {
+            removed |= video.renditions.remove(name).is_some();
+            if video.renditions.is_empty() {
+                self.video = None;
+            }
+        }
+
+        if let Some(audio) = &mut self.audio {
+            removed |= audio.renditions.remove(name).is_some();
+            if audio.renditions.is_empty() {
+                self.audio = None;
+            }
+        }
+
+        if self.location.as_ref().is_some_and(|l| l.track == name) {
+            self.location = None;
+            removed = true;
+        }
+
+        if self.chat.as_ref().is_some_and(|c| c.track == name) {
+            self.chat = None;
+            removed = true;
+        }
+
+        if self.preview.as_ref().is_some_and(|p| p.name == name) {
+            self.preview = None;
+            removed = true;
+        }
+
+        removed
+    }
+}
+
+/// Default video rendition used for tracks created from a bare `TrackDefinition`
+fn default_video_config() -> HangVideoConfig {
+    HangVideoConfig {
+        codec: "avc1.42001e".to_string(), // H.264 baseline profile
+        description: None,
+        coded_width: Some(1280),
+        coded_height: Some(720),
+        display_ratio_width: None,
+        display_ratio_height: None,
+        bitrate: Some(2_000_000), // 2 Mbps default
+        framerate: Some(30.0),
+        optimize_for_latency: Some(true),
+    }
+}
+
+/// Default audio rendition used for tracks created from a bare `TrackDefinition`
+fn default_audio_config() -> HangAudioConfig {
+    HangAudioConfig {
+        codec: "opus".to_string(),
+        sample_rate: 48000,
+        channel_count: 2,
+        bitrate: Some(128_000), // 128 kbps default
+        description: None,
+    }
+}
+
+/// A JSON-Patch-style catalog delta, keyed by track name
+///
+/// Every catalog.json group starts with a full snapshot frame; each later frame in the
+/// same group is a JSON array of these operations, applied in order against the
+/// catalog produced by the previous frame:
+///
+/// `[{"op":"add","path":"/tracks/camera2","value":{"name":"camera2",...}},
+///   {"op":"remove","path":"/tracks/camera1"}]`
+///
+/// Track names are escaped in `path` as JSON Pointer tokens (`~` -> `~0`, `/` -> `~1`).
+#[derive(Clone, Debug, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(tag = "op", rename_all = "lowercase")]
+pub enum CatalogPatch {
+    Add {
+        path: String,
+        value: TrackDefinition,
+    },
+    Remove {
+        path: String,
+    },
+}
+
+impl CatalogPatch {
+    pub fn add(track: &TrackDefinition) -> Self {
+        CatalogPatch::Add {
+            path: track_path(&track.name),
+            value: track.clone(),
+        }
+    }
+
+    pub fn remove(name: &str) -> Self {
+        CatalogPatch::Remove {
+            path: track_path(name),
+        }
+    }
+
+    /// Serialize a delta frame
+    pub fn to_json(patches: &[CatalogPatch]) -> Result<String, serde_json::Error> {
+        serde_json::to_string(patches)
+    }
+
+    /// Parse a delta frame
+    pub fn from_json(json: &str) -> Result<Vec<CatalogPatch>, serde_json::Error> {
+        serde_json::from_str(json)
+    }
+
+    /// Serialize a delta frame in the given wire encoding
+    pub fn encode(
+        patches: &[CatalogPatch],
+        encoding: CatalogEncoding,
+    ) -> Result<Bytes, CatalogError> {
+        encoding.encode(&patches)
+    }
+
+    /// Parse a delta frame in the given wire encoding
+    pub fn decode(
+        bytes: &[u8],
+        encoding: CatalogEncoding,
+    ) -> Result<Vec<CatalogPatch>, CatalogError> {
+        encoding.decode(bytes)
+    }
+}
+
+/// Tracks that appeared in or disappeared from a catalog
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct CatalogUpdate {
+    /// Catalog version (the catalog.json group sequence the change arrived in)
+    pub version: u64,
+    pub added: Vec<String>,
+    pub removed: Vec<String>,
+}
+
+impl CatalogUpdate {
+    pub fn is_empty(&self) -> bool {
+        self.added.is_empty() && self.removed.is_empty()
+    }
+
+    /// Fold a later change into this one
+    pub fn merge(&mut self, other: CatalogUpdate) {
+        for name in other.added {
+            if let Some(pos) = self.removed.iter().position(|n| *n == name) {
+                self.removed.remove(pos);
+            } else {
+                self.added.push(name);
+            }
+        }
+        for name in other.removed {
+            if let Some(pos) = self.added.iter().position(|n| *n == name) {
+                self.added.remove(pos);
+            } else {
+                self.removed.push(name);
+            }
+        }
+    }
+}
+
+fn track_path(name: &str) -> String {
+    format!("/tracks/{}", name.replace('~', "~0").replace('/', "~1"))
+}
+
+fn track_name_from_path(path: &str) -> Option<String> {
+    path.strip_prefix("/tracks/")
+        .map(|token| token.replace("~1", "/").replace("~0", "~"))
 }
 
 #[derive(Clone, Debug)]
@@ -466,6 +809,14 @@ impl Catalog {
         }
     }
 
+    /// Serialize the catalog snapshot in the given wire encoding
+    pub fn encode(&self, encoding: CatalogEncoding) -> Result<Bytes, CatalogError> {
+        match self {
+            Catalog::Sesame(catalog) => encoding.encode(catalog),
+            Catalog::Hang(catalog) => encoding.encode(catalog),
+        }
+    }
+
     pub fn find_track(&self, name: &str) -> bool {
         match self {
             Catalog::Sesame(catalog) => catalog.find_track(name).is_some(),
@@ -473,6 +824,197 @@ impl Catalog {
         }
     }
 
+    /// Add a track to the catalog
+    pub fn add_track(&mut self, track: &TrackDefinition) {
+        match self {
+            Catalog::Sesame(catalog) => catalog.add_track(track),
+            Catalog::Hang(catalog) => catalog.add_track(track),
+        }
+    }
+
+    /// Remove a track from the catalog, returning true if it was present
+    pub fn remove_track(&mut self, name: &str) -> bool {
+        match self {
+            Catalog::Sesame(catalog) => catalog.remove_track(name),
+            Catalog::Hang(catalog) => catalog.remove_track(name),
+        }
+    }
+
+    /// All tracks listed in the catalog
+    ///
+    /// Hang renditions take the priority of their video/audio section; location, chat and
+    /// preview tracks are reported as data tracks.
+    pub fn tracks(&self) -> Vec<TrackDefinition> {
+        match self {
+            Catalog::Sesame(catalog) => catalog
+                .tracks
+                .iter()
+                .map(|t| {
+                    TrackDefinition::new(t.track_name.clone(), t.priority, t.track_type.clone())
+                })
+                .collect(),
+            Catalog::Hang(catalog) => {
+                let mut tracks = Vec::new();
+                if let Some(video) = &catalog.video {
+                    tracks.extend(
+                        video.renditions.keys().map(|name| {
+                            TrackDefinition::video(name.clone(), video.priority as u32)
+                        }),
+                    );
+                }
+                if let Some(audio) = &catalog.audio {
+                    tracks.extend(
+                        audio.renditions.keys().map(|name| {
+                            TrackDefinition::audio(name.clone(), audio.priority as u32)
+                        }),
+                    );
+                }
+                if let Some(location) = &catalog.location {
+                    tracks.push(TrackDefinition::data(
+                        location.track.clone(),
+                        location.priority as u32,
+                    ));
+                }
+                if let Some(chat) = &catalog.chat {
+                    tracks.push(TrackDefinition::data(
+                        chat.track.clone(),
+                        chat.priority as u32,
+                    ));
+                }
+                if let Some(preview) = &catalog.preview {
+                    tracks.push(TrackDefinition::data(
+                        preview.name.clone(),
+                        preview.priority as u32,
+                    ));
+                }
+                tracks
+            }
+        }
+    }
+
+    /// The catalog's track with the given name, as listed by `tracks`
+    pub fn track(&self, name: &str) -> Option<TrackDefinition> {
+        match self {
+            Catalog::Sesame(catalog) => catalog.find_track(name).map(|t| {
+                TrackDefinition::new(t.track_name.clone(), t.priority, t.track_type.clone())
+            }),
+            Catalog::Hang(catalog) => {
+                if let Some(video) = catalog
+                    .video
+                    .as_ref()
+                    .filter(|video| video.renditions.contains_key(name))
+                {
+                    return Some(TrackDefinition::video(name, video.priority as u32));
+                }
+                if let Some(audio) = catalog
+                    .audio
+                    .as_ref()
+                    .filter(|audio| audio.renditions.contains_key(name))
+                {
+                    return Some(TrackDefinition::audio(name, audio.priority as u32));
+                }
+                [
+                    catalog.location.as_ref().map(|l| (&l.track, l.priority)),
+                    catalog.chat.as_ref().map(|c| (&c.track, c.priority)),
+                    catalog.preview.as_ref().map(|p| (&p.name, p.priority)),
+                ]
+                .into_iter()
+                .flatten()
+                .find(|(track, _)| *track == name)
+                .map(|(track, priority)| TrackDefinition::data(track.clone(), priority as u32))
+            }
+        }
+    }
+
+    /// Names of all tracks listed in the catalog
+    pub fn track_names(&self) -> Vec<String> {
+        match self {
+            Catalog::Sesame(catalog) => catalog
+                .tracks
+                .iter()
+                .map(|t| t.track_name.clone())
+                .collect(),
+            Catalog::Hang(catalog) => {
+                let mut names = Vec::new();
+                if let Some(video) = &catalog.video {
+                    names.extend(video.renditions.keys().cloned());
+                }
+                if let Some(audio) = &catalog.audio {
+                    names.extend(audio.renditions.keys().cloned());
+                }
+                if let Some(location) = &catalog.location {
+                    names.push(location.track.clone());
+                }
+                if let Some(chat) = &catalog.chat {
+                    names.push(chat.track.clone());
+                }
+                if let Some(preview) = &catalog.preview {
+                    names.push(preview.name.clone());
+                }
+                names
+            }
+        }
+    }
+
+    /// Apply a delta in place, returning the resulting change (if any)
+    pub fn apply_patch(&mut self, patch: &CatalogPatch) -> CatalogUpdate {
+        let mut update = CatalogUpdate::default();
+        match patch {
+            CatalogPatch::Add { value, .. } => {
+                if !self.find_track(&value.name) {
+                    update.added.push(value.name.clone());
+                }
+                // A Hang catalog has one preview track, which a new data track replaces
+                let replaced = match self {
+                    Catalog::Hang(catalog) if value.track_type == TrackType::Data => catalog
+                        .preview
+                        .as_ref()
+                        .map(|preview| preview.name.clone())
+                        .filter(|name| *name != value.name),
+                    _ => None,
+                };
+                self.add_track(value);
+                if let Some(name) = replaced.filter(|name| !self.find_track(name)) {
+                    update.removed.push(name);
+                }
+            }
+            CatalogPatch::Remove { path } => {
+                if let Some(name) = track_name_from_path(path) {
+                    if self.remove_track(&name) {
+                        update.removed.push(name);
+                    }
+                }
+            }
+        }
+        update
+    }
+
+    /// Tracks added and removed going from `previous` to `self`
+    pub fn diff(&self, previous: Option<&Catalog>) -> CatalogUpdate {
+        let current: HashSet<String> = self.track_names().into_iter().collect();
+        let previous: HashSet<String> = previous
+            .map(|catalog| catalog.track_names().into_iter().collect())
+            .unwrap_or_default();
+
+        CatalogUpdate {
+            version: 0,
+            added: current.difference(&previous).cloned().collect(),
+            removed: previous.difference(&current).cloned().collect(),
+        }
+    }
+
+    /// Parse a snapshot frame according to the negotiated catalog type
+    pub fn decode(catalog_type: &CatalogType, bytes: &[u8]) -> Result<Catalog, CatalogError> {
+        let encoding = catalog_type.encoding();
+        match catalog_type {
+            CatalogType::Sesame => encoding.decode(bytes).map(Catalog::Sesame),
+            CatalogType::Hang => encoding
+                .decode(bytes)
+                .map(|catalog| Catalog::Hang(Box::new(catalog))),
+            CatalogType::None => Err(CatalogError::NoCatalogType),
+        }
+    }
+
     pub fn parse_sesame(json: &str) -> Result<SesameCatalog, serde_json::Error> {
         SesameCatalog::from_json(json)
     }
@@ -480,6 +1022,130 @@ impl Catalog {
     pub fn parse_hang(json: &str) -> Result<HangCatalog, serde_json::Error> {
         HangCatalog::from_json(json)
     }
+
+    /// Parse a Sesame snapshot in the given wire encoding
+    pub fn decode_sesame(
+        bytes: &[u8],
+        encoding: CatalogEncoding,
+    ) -> Result<SesameCatalog, CatalogError> {
+        encoding.decode(bytes)
+    }
+}
+
+/// Immutable view of a subscribed catalog, with its tracks sorted by name
+///
+/// A new snapshot is built for every catalog change, so holders of an `Arc<CatalogSnapshot>`
+/// never observe a partially applied update. Snapshots built from deltas share the track
+/// definitions that did not change, and the native catalog of the last full snapshot
+/// frame; the patched native catalog is only built if `catalog` is called.
+#[derive(Clone, Debug)]
+pub struct CatalogSnapshot {
+    version: u64,
+    // Catalog of the last full snapshot frame
+    base: Arc<Catalog>,
+    // Deltas received since `base`, in order
+    patches: Vec<CatalogPatch>,
+    // `base` with `patches` applied, built on first use
+    patched: OnceLock<Catalog>,
+    tracks: Vec<Arc<TrackDefinition>>,
+}
+
+impl CatalogSnapshot {
+    pub fn new(version: u64, catalog: Catalog) -> Self {
+        let mut tracks: Vec<Arc<TrackDefinition>> =
+            catalog.tracks().into_iter().map(Arc::new).collect();
+        tracks.sort_by(|a, b| a.name.cmp(&b.name));
+        Self {
+            version,
+            base: Arc::new(catalog),
+            patches: Vec::new(),
+            patched: OnceLock::new(),
+            tracks,
+        }
+    }
+
+    /// The snapshot after `patches`, where `catalog` is the catalog they produced
+    ///
+    /// Only tracks named by a patch (and data tracks a new data track may replace) are
+    /// looked up again; the other definitions are shared with this snapshot.
+    pub fn with_patches(&self, version: u64, patches: &[CatalogPatch], catalog: &Catalog) -> Self {
+        let mut tracks = self.tracks.clone();
+        let mut touched: Vec<String> = Vec::new();
+        for patch in patches {
+            match patch {
+                CatalogPatch::Add { value, .. } => {
+                    if value.track_type == TrackType::Data {
+                        touched.extend(
+                            tracks
+                                .iter()
+                                .filter(|track| track.track_type == TrackType::Data)
+                                .map(|track| track.name.clone()),
+                        );
+                    }
+                    touched.push(value.name.clone());
+                }
+                CatalogPatch::Remove { path } => touched.extend(track_name_from_path(path)),
+            }
+        }
+
+        for name in touched {
+            let position = tracks.binary_search_by(|track| track.name.as_str().cmp(&name));
+            match (position, catalog.track(&name)) {
+                (Ok(i), Some(track)) => {
+                    if *tracks[i] != track {
+                        tracks[i] = Arc::new(track);
+                    }
+                }
+                (Err(i), Some(track)) => tracks.insert(i, Arc::new(track)),
+                (Ok(i), None) => {
+                    tracks.remove(i);
+                }
+                (Err(_), None) => {}
+            }
+        }
+
+        let mut all_patches = self.patches.clone();
+        all_patches.extend_from_slice(patches);
+        Self {
+            version,
+            base: self.base.clone(),
+            patches: all_patches,
+            patched: OnceLock::new(),
+            tracks,
+        }
+    }
+
+    /// Catalog version (the catalog.json group sequence of the last applied frame)
+    pub fn version(&self) -> u64 {
+        self.version
+    }
+
+    /// The parsed catalog in its native format
+    pub fn catalog(&self) -> &Catalog {
+        if self.patches.is_empty() {
+            return &self.base;
+        }
+        self.patched.get_or_init(|| {
+            let mut catalog = (*self.base).clone();
+            for patch in &self.patches {
+                catalog.apply_patch(patch);
+            }
+            catalog
+        })
+    }
+
+    /// All tracks, sorted by name
+    pub fn tracks(&self) -> &[Arc<TrackDefinition>] {
+        &self.tracks
+    }
+
+    /// Look up a track by name
+    pub fn find_track(&self, name: &str) -> Option<&TrackDefinition> {
+        self.tracks
+            .binary_search_by(|track| track.name.as_str().cmp(name))
+            .ok()
+            .map(|i| &*self.tracks[i])
+    }
 }
 
 #[cfg(test)]
@@ -492,6 +1158,14 @@ mod tests {
         assert_eq!(track.name, "test-video");
         assert_eq!(track.priority, 1);
         assert_eq!(track.track_type, TrackType::Video);
+        assert_eq!(track.start, StartPosition::Any);
+
+        // The start position is local to the subscriber and never published
+        let latest = track.clone().with_start(StartPosition::Latest);
+        assert_eq!(
+            serde_json::to_string(&latest).unwrap(),
+            serde_json::to_string(&track).unwrap()
+        );
     }
 
     #[test]
@@ -564,6 +1238,220 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_catalog_add_remove_track() {
+        let tracks = vec![TrackDefinition::video("camera1", 1)];
+
+        let mut sesame = Catalog::new(CatalogType::Sesame, &tracks).unwrap();
+        sesame.add_track(&TrackDefinition::video("camera2", 1));
+        assert!(sesame.find_track("camera2"));
+        assert!(sesame.remove_track("camera1"));
+        assert!(!sesame.remove_track("camera1"));
+        assert!(!sesame.find_track("camera1"));
+        assert!(sesame.find_track("camera2"));
+
+        let mut hang = Catalog::new(CatalogType::Hang, &tracks).unwrap();
+        hang.add_track(&TrackDefinition::video("camera2", 1));
+        hang.add_track(&TrackDefinition::audio("mic", 2));
+        assert!(hang.find_track("camera1"));
+        assert!(hang.find_track("camera2"));
+        assert!(hang.remove_track("mic"));
+        assert!(hang.remove_track("camera1"));
+        assert!(hang.remove_track("camera2"));
+
+        if let Catalog::Hang(catalog) = &hang {
+            assert!(catalog.video.is_none());
+            assert!(catalog.audio.is_none());
+        }
+    }
+
+    #[test]
+    fn test_catalog_patch() {
+        let mut catalog = Catalog::new(
+            CatalogType::Sesame,
+            &[
+                TrackDefinition::video("camera1", 1),
+                TrackDefinition::data("a/b~c", 3),
+            ],
+        )
+        .unwrap();
+        let previous = catalog.clone();
+
+        let patches = vec![
+            CatalogPatch::add(&TrackDefinition::video("camera2", 1)),
+            CatalogPatch::remove("a/b~c"),
+        ];
+        let json = CatalogPatch::to_json(&patches).unwrap();
+        assert!(json.contains("\"path\":\"/tracks/a~1b~0c\""));
+
+        let mut update = CatalogUpdate::default();
+        for patch in CatalogPatch::from_json(&json).unwrap() {
+            update.merge(catalog.apply_patch(&patch));
+        }
+        assert_eq!(update.added, vec!["camera2".to_string()]);
+        assert_eq!(update.removed, vec!["a/b~c".to_string()]);
+        assert!(catalog.find_track("camera2"));
+        assert!(!catalog.find_track("a/b~c"));
+
+        // Re-adding an existing track and removing an unknown one are not changes
+        assert!(catalog
+            .apply_patch(&CatalogPatch::add(&TrackDefinition::video("camera2", 1)))
+            .is_empty());
+        assert!(catalog
+            .apply_patch(&CatalogPatch::remove("missing"))
+            .is_empty());
+
+        let diff = catalog.diff(Some(&previous));
+        assert_eq!(diff.added, vec!["camera2".to_string()]);
+        assert_eq!(diff.removed, vec!["a/b~c".to_string()]);
+    }
+
+    #[test]
+    fn test_catalog_encodings() {
+        let tracks: Vec<TrackDefinition> = (0..100)
+            .map(|i| TrackDefinition::video(format!("camera{}", i), i % 4))
+            .collect();
+        let catalog = Catalog::new(CatalogType::Sesame, &tracks).unwrap();
+        assert_eq!(CatalogType::Sesame.encoding(), CatalogEncoding::Json);
+
+        let json = catalog.encode(CatalogEncoding::Json).unwrap();
+        assert!(!json.contains(&b'\n'));
+        assert_eq!(json, catalog.to_json().unwrap().as_bytes());
+        let parsed = Catalog::decode_sesame(&json, CatalogEncoding::Json).unwrap();
+        assert_eq!(parsed.tracks.len(), 100);
+        assert!(parsed.find_track("camera99").is_some());
+
+        let patches = vec![
+            CatalogPatch::add(&TrackDefinition::audio("mic", 2)),
+            CatalogPatch::remove("camera0"),
+        ];
+        let delta = CatalogPatch::encode(&patches, CatalogEncoding::Json).unwrap();
+        assert_eq!(
+            CatalogPatch::decode(&delta, CatalogEncoding::Json).unwrap(),
+            patches
+        );
+
+        // A truncated snapshot is rejected
+        assert!(Catalog::decode_sesame(&json[..json.len() / 2], CatalogEncoding::Json).is_err());
+    }
+
+    #[test]
+    fn test_catalog_decode_by_type() {
+        let tracks = vec![
+            TrackDefinition::video("camera", 1),
+            TrackDefinition::audio("mic", 2),
+            TrackDefinition::data("telemetry", 3),
+        ];
+
+        let hang = Catalog::new(CatalogType::Hang, &tracks).unwrap();
+        let bytes = hang.encode(CatalogEncoding::Json).unwrap();
+        let parsed = Catalog::decode(&CatalogType::Hang, &bytes).unwrap();
+        assert!(matches!(parsed, Catalog::Hang(_)));
+
+        let snapshot = CatalogSnapshot::new(7, parsed);
+        assert_eq!(snapshot.version(), 7);
+        assert_eq!(snapshot.tracks().len(), 3);
+        assert_eq!(
+            snapshot.find_track("mic"),
+            Some(&TrackDefinition::audio("mic", 2))
+        );
+        assert_eq!(
+            snapshot.find_track("telemetry").map(|t| &t.track_type),
+            Some(&TrackType::Data)
+        );
+        assert!(snapshot.find_track("missing").is_none());
+
+        let sesame = Catalog::new(CatalogType::Sesame, &tracks).unwrap();
+        let bytes = sesame.encode(CatalogEncoding::Json).unwrap();
+        let parsed = Catalog::decode(&CatalogType::Sesame, &bytes).unwrap();
+        assert_eq!(parsed.tracks(), tracks);
+        assert!(Catalog::decode(&CatalogType::None, &bytes).is_err());
+    }
+
+    #[test]
+    fn test_catalog_snapshot_patches() {
+        let tracks: Vec<TrackDefinition> = (0..20)
+            .map(|i| TrackDefinition::video(format!("camera{:02}", i), 1))
+            .chain([
+                TrackDefinition::audio("mic", 2),
+                TrackDefinition::data("thumbs", 3),
+            ])
+            .collect();
+        let mut catalog = Catalog::new(CatalogType::Hang, &[]).unwrap();
+        for track in &tracks {
+            catalog.add_track(track);
+        }
+        let snapshot = CatalogSnapshot::new(1, catalog.clone());
+
+        // Sorted by name, so decodes with a different rendition order compare equal
+        let names: Vec<&str> = snapshot.tracks().iter().map(|t| t.name.as_str()).collect();
+        let mut sorted = names.clone();
+        sorted.sort();
+        assert_eq!(names, sorted);
+        let bytes = catalog.encode(CatalogEncoding::Json).unwrap();
+        let decoded = Catalog::decode(&CatalogType::Hang, &bytes).unwrap();
+        assert_eq!(CatalogSnapshot::new(1, decoded).tracks(), snapshot.tracks());
+
+        // A new data track replaces the Hang preview, which is reported as removed
+        let patches = vec![
+            CatalogPatch::add(&TrackDefinition::video("camera20", 1)),
+            CatalogPatch::remove("camera03"),
+            CatalogPatch::add(&TrackDefinition::data("preview", 4)),
+        ];
+        let mut update = CatalogUpdate::default();
+        for patch in &patches {
+            update.merge(catalog.apply_patch(patch));
+        }
+        assert_eq!(update.removed, vec!["camera03", "thumbs"]);
+        let patched = snapshot.with_patches(2, &patches, &catalog);
+
+        assert_eq!(patched.version(), 2);
+        assert_eq!(
+            patched.tracks(),
+            CatalogSnapshot::new(2, catalog.clone()).tracks()
+        );
+        assert!(patched.find_track("camera20").is_some());
+        assert!(patched.find_track("camera03").is_none());
+        assert!(patched.find_track("thumbs").is_none());
+        assert_eq!(patched.catalog().track_names().len(), 22);
+
+        // Unchanged definitions are shared, not copied
+        let before = snapshot.tracks().iter().find(|t| t.name == "mic").unwrap();
+        let after = patched.tracks().iter().find(|t| t.name == "mic").unwrap();
+        assert!(Arc::ptr_eq(before, after));
+    }
+
+    #[test]
+    fn test_track_filter() {
+        assert!(glob_match("camera*", "camera1"));
+        assert!(glob_match("camera*", "camera"));
+        assert!(glob_match("*/hd", "room1/hd"));
+        assert!(glob_match("cam?ra-*-hd", "camera-main-hd"));
+        assert!(glob_match("*a*b*", "xxaxxbxx"));
+        assert!(!glob_match("camera?", "camera"));
+        assert!(!glob_match("*/hd", "room1/sd"));
+        assert!(!glob_match("mic", "mic2"));
+
+        let camera = TrackDefinition::video("camera1", 2);
+        let mic = TrackDefinition::audio("mic", 5);
+
+        assert!(TrackFilter::any().matches(&camera));
+        assert!(TrackFilter::any()
+            .with_type(TrackType::Video)
+            .matches(&camera));
+        assert!(!TrackFilter::any().with_type(TrackType::Video).matches(&mic));
+        assert!(TrackFilter::any().with_max_priority(2).matches(&camera));
+        assert!(!TrackFilter::any().with_max_priority(2).matches(&mic));
+
+        let filter = TrackFilter::any()
+            .with_type(TrackType::Video)
+            .with_name_glob("camera*")
+            .with_max_priority(3);
+        assert!(filter.matches(&camera));
+        assert!(!filter.matches(&TrackDefinition::video("screen", 1)));
+        assert!(!filter.matches(&TrackDefinition::video("camera2", 4)));
+    }
+
     #[test]
     fn test_hang_catalog_json_format() {
         let mut catalog = HangCatalog::new();
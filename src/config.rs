@@ -69,6 +69,52 @@ impl Default for ConnectionConfig {
     }
 }
 
+/// How frames are delivered when several groups of a track are read at once
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum GroupOrder {
+    /// Deliver frames as soon as they arrive, from any group in the window
+    #[default]
+    Arrival,
+    /// Deliver group by group in sequence order, buffering newer groups
+    ///
+    /// A few frames of each newer group are buffered; its reader then waits for the older
+    /// groups to be delivered.
+    Sequence,
+    /// Like `Sequence`, but skip an unfinished group once a newer group completes
+    ///
+    /// Only newer groups that fit in their read-ahead buffer can complete while an older one
+    /// stalls; a `LatencyPolicy` bounds the wait otherwise.
+    SequenceSkipStale,
+}
+
+/// Bounds how far a subscriber may fall behind the live edge of a track
+///
+/// When a limit is exceeded, the queued groups are dropped and reading resumes at the
+/// newest one; a group still being read is abandoned. Checked as groups arrive, when the
+/// oldest queued group reaches `max_latency`, and whenever a group has been read; with a
+/// `group_window` above 1, the groups open behind the oldest one count as queued, checked
+/// as groups open and finish.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct LatencyPolicy {
+    /// Maximum time the oldest queued group may wait
+    pub max_latency: Option<Duration>,
+
+    /// Maximum number of groups queued behind the one being read
+    pub max_pending_groups: Option<usize>,
+}
+
+impl LatencyPolicy {
+    /// Whether `pending` queued groups, the oldest waiting `oldest_wait`, exceed the policy
+    pub fn is_exceeded(&self, pending: usize, oldest_wait: Duration) -> bool {
+        self.max_pending_groups.is_some_and(|max| pending > max)
+            || (pending > 0 && self.max_latency.is_some_and(|max| oldest_wait > max))
+    }
+}
+
+/// Session settings
+///
+/// Fields are added as the library grows; build a config with `SessionConfig::new`, or
+/// as a struct literal ending in `..Default::default()`, so new fields take their defaults.
 #[derive(Clone, Debug)]
 pub struct SessionConfig {
     /// Name/path of the broadcast
@@ -76,6 +122,41 @@ pub struct SessionConfig {
 
     /// Connection configuration
     pub connection: ConnectionConfig,
+
+    /// Maximum number of track subscriptions waiting for their first group at once
+    /// (0 = unlimited). A track with no group after a few seconds stops counting.
+    pub max_concurrent_subscriptions: usize,
+
+    /// Quiet period before acting on a re-announcement of the subscribed broadcast, so a
+    /// flapping announcement triggers a single resubscription
+    pub announce_debounce: Duration,
+
+    /// Groups read concurrently per track (1 = read each group to completion before the
+    /// next). When the window is full, the oldest group is dropped for the newest. Tracks
+    /// in chunked delivery mode are always read one group at a time.
+    pub group_window: usize,
+
+    /// Delivery order for frames of concurrently read groups
+    pub group_order: GroupOrder,
+
+    /// Threads running data callbacks of queued tracks off the network runtime, started once
+    /// a track is switched to queued delivery (0 = always call callbacks on the task reading
+    /// each track)
+    pub delivery_threads: usize,
+}
+
+impl Default for SessionConfig {
+    fn default() -> Self {
+        Self {
+            broadcast_name: String::new(),
+            connection: ConnectionConfig::default(),
+            max_concurrent_subscriptions: 16,
+            announce_debounce: Duration::from_millis(200),
+            group_window: 1,
+            group_order: GroupOrder::default(),
+            delivery_threads: 2,
+        }
+    }
 }
 
 impl SessionConfig {
@@ -86,6 +167,7 @@ impl SessionConfig {
                 url,
                 ..Default::default()
             },
+            ..Default::default()
         }
     }
 }
@@ -0,0 +1,556 @@
+use std::collections::{HashMap, VecDeque};
+use std::sync::mpsc;
+use std::sync::{Arc, Mutex, RwLock};
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant};
+use tokio::sync::Notify;
+use tracing::{debug, warn};
+
+use crate::frame::{FrameReceivers, ReceivedFrame};
+
+/// Frames a delivery thread takes from one track before letting other tracks run
+const DRAIN_BATCH: usize = 32;
+
+/// Callback receiving a batch of a track's frames in one call
+pub type FrameBatchCallback = Arc<dyn Fn(&str, &[ReceivedFrame]) + Send + Sync>;
+
+/// Batched delivery of queued frames
+///
+/// Frames are handed over once `max_frames` are queued or the oldest has waited
+/// `max_delay`, whichever comes first. A zero delay delivers whatever is ready.
+#[derive(Clone)]
+pub struct FrameBatching {
+    pub callback: FrameBatchCallback,
+    pub max_frames: usize,
+    pub max_delay: Duration,
+}
+
+type SharedBatching = Arc<RwLock<Option<FrameBatching>>>;
+
+/// What to do with a frame when its track's delivery queue is full
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum OverflowPolicy {
+    /// Wait for room, pushing back on the track's reader
+    #[default]
+    Block,
+    /// Drop the oldest queued frame
+    DropOldest,
+    /// Drop the incoming frame
+    DropNewest,
+}
+
+/// How frames of a track reach the data callback
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum DeliveryMode {
+    /// Call the callback on the task reading the track (lowest latency)
+    #[default]
+    Inline,
+    /// Queue frames for the delivery threads, in order
+    Queued {
+        capacity: usize,
+        overflow: OverflowPolicy,
+    },
+}
+
+/// Power-of-two histogram; bucket `i` counts values in `[2^(i-1), 2^i)`, bucket 0 counts 0
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct Histogram {
+    pub buckets: [u64; 64],
+}
+
+impl Default for Histogram {
+    fn default() -> Self {
+        Self { buckets: [0; 64] }
+    }
+}
+
+impl Histogram {
+    pub fn record(&mut self, value: u64) {
+        let bucket = (u64::BITS - value.leading_zeros()) as usize;
+        self.buckets[bucket.min(63)] += 1;
+    }
+
+    pub fn count(&self) -> u64 {
+        self.buckets.iter().sum()
+    }
+
+    /// Upper bound of the bucket holding the given percentile (0-100)
+    pub fn percentile(&self, percentile: f64) -> u64 {
+        let target = (self.count() as f64 * percentile / 100.0).ceil() as u64;
+        let mut seen = 0;
+        for (bucket, count) in self.buckets.iter().enumerate() {
+            seen += count;
+            if seen >= target.max(1) {
+                return if bucket == 0 { 0 } else { (1u64 << bucket) - 1 };
+            }
+        }
+        0
+    }
+}
+
+/// Delivery counters for one track
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct DeliveryStats {
+    /// Frames handed to the data callback
+    pub delivered: u64,
+    /// Frames dropped by the overflow policy
+    pub dropped: u64,
+    /// Queue depth seen by each frame when it was queued
+    pub queue_depth: Histogram,
+    /// Callback duration in microseconds, once per frame or per batch
+    pub callback_us: Histogram,
+}
+
+struct QueueState {
+    mode: DeliveryMode,
+    frames: VecDeque<ReceivedFrame>,
+    // Held by one delivery thread at a time, which keeps the track in order
+    scheduled: bool,
+    // A timer will schedule the queue once the batch delay runs out
+    flush_pending: bool,
+    receivers: Option<FrameReceivers>,
+    stats: DeliveryStats,
+}
+
+/// Per-track delivery queue
+pub struct TrackQueue {
+    track_name: String,
+    state: Mutex<QueueState>,
+    space: Notify,
+    ready_tx: ReadySender,
+    batching: SharedBatching,
+}
+
+/// Tracks with frames to deliver; `None` stops one delivery thread
+type ReadySender = mpsc::Sender<Option<Arc<TrackQueue>>>;
+type ReadyReceiver = Arc<Mutex<mpsc::Receiver<Option<Arc<TrackQueue>>>>>;
+
+impl TrackQueue {
+    /// Hand a frame to the data callback according to the track's delivery mode
+    pub async fn push(self: &Arc<Self>, frame: ReceivedFrame) {
+        let mut frame = Some(frame);
+        loop {
+            let inline_receivers = {
+                let Ok(mut state) = self.state.lock() else {
+                    return;
+                };
+                match state.mode {
+                    DeliveryMode::Inline => state.receivers.clone(),
+                    DeliveryMode::Queued { capacity, overflow } => {
+                        if state.frames.len() < capacity.max(1) {
+                            self.enqueue(&mut state, frame.take());
+                            return;
+                        }
+                        match overflow {
+                            // Wait below until a delivery thread makes room
+                            OverflowPolicy::Block => None,
+                            OverflowPolicy::DropNewest => {
+                                state.stats.dropped += 1;
+                                return;
+                            }
+                            OverflowPolicy::DropOldest => {
+                                state.frames.pop_front();
+                                state.stats.dropped += 1;
+                                self.enqueue(&mut state, frame.take());
+                                return;
+                            }
+                        }
+                    }
+                }
+            };
+
+            let Some(receivers) = inline_receivers else {
+                self.space.notified().await;
+                continue;
+            };
+            if let Some(frame) = frame {
+                let started = Instant::now();
+                receivers.deliver(&self.track_name, &frame).await;
+                if let Some(batching) = self.batching() {
+                    (batching.callback)(&self.track_name, std::slice::from_ref(&frame));
+                }
+                self.record_callback(1, started.elapsed());
+            }
+            return;
+        }
+    }
+
+    fn enqueue(self: &Arc<Self>, state: &mut QueueState, frame: Option<ReceivedFrame>) {
+        let Some(frame) = frame else {
+            return;
+        };
+        state.stats.queue_depth.record(state.frames.len() as u64);
+        state.frames.push_back(frame);
+        if state.scheduled {
+            return;
+        }
+        match self.batching() {
+            // Let the batch fill up; the timer flushes a partial one
+            Some(batching)
+                if !batching.max_delay.is_zero() && state.frames.len() < batching.max_frames =>
+            {
+                if !state.flush_pending {
+                    state.flush_pending = true;
+                    let queue = self.clone();
+                    tokio::spawn(async move {
+                        tokio::time::sleep(batching.max_delay).await;
+                        queue.flush();
+                    });
+                }
+            }
+            _ => state.scheduled = self.ready_tx.send(Some(self.clone())).is_ok(),
+        }
+    }
+
+    /// Schedule a partial batch whose delay ran out
+    fn flush(self: &Arc<Self>) {
+        let Ok(mut state) = self.state.lock() else {
+            return;
+        };
+        state.flush_pending = false;
+        if !state.scheduled && !state.frames.is_empty() {
+            state.scheduled = self.ready_tx.send(Some(self.clone())).is_ok();
+        }
+    }
+
+    fn batching(&self) -> Option<FrameBatching> {
+        self.batching.read().ok()?.clone()
+    }
+
+    /// Deliver a batch of queued frames on a delivery thread
+    fn drain(self: &Arc<Self>) {
+        let batching = self.batching();
+        let (batch, receivers) = {
+            let Ok(mut state) = self.state.lock() else {
+                return;
+            };
+            if state.frames.is_empty() {
+                state.scheduled = false;
+                return;
+            }
+            let limit = batching
+                .as_ref()
+                .map_or(DRAIN_BATCH, |batching| batching.max_frames.max(1));
+            let count = state.frames.len().min(limit);
+            let batch: Vec<ReceivedFrame> = state.frames.drain(..count).collect();
+            (batch, state.receivers.clone())
+        };
+        self.space.notify_one();
+
+        if let Some(receivers) = receivers {
+            for frame in &batch {
+                let started = Instant::now();
+                receivers.blocking_deliver(&self.track_name, frame);
+                if batching.is_none() {
+                    self.record_callback(1, started.elapsed());
+                }
+            }
+        }
+        if let Some(batching) = batching {
+            let started = Instant::now();
+            (batching.callback)(&self.track_name, &batch);
+            self.record_callback(batch.len() as u64, started.elapsed());
+        }
+
+        // Go behind the other ready tracks; the next drain unschedules once empty
+        if self.ready_tx.send(Some(self.clone())).is_err() {
+            if let Ok(mut state) = self.state.lock() {
+                state.scheduled = false;
+            }
+        }
+    }
+
+    fn record_callback(&self, frames: u64, duration: Duration) {
+        if let Ok(mut state) = self.state.lock() {
+            state.stats.delivered += frames;
+            state.stats.callback_us.record(duration.as_micros() as u64);
+        }
+    }
+
+    pub fn stats(&self) -> DeliveryStats {
+        self.state
+            .lock()
+            .map(|state| state.stats.clone())
+            .unwrap_or_default()
+    }
+}
+
+/// Pool of delivery threads running data callbacks off the Tokio runtime
+///
+/// Tracks are delivered inline until one is switched to queued delivery, which starts the
+/// threads. Each queued track has its own bounded queue, drained by at most one thread at a
+/// time, so a slow callback only holds back its own track. Dropping the executor stops and
+/// joins the threads.
+pub struct DeliveryExecutor {
+    ready_tx: ReadySender,
+    ready_rx: ReadyReceiver,
+    thread_count: usize,
+    threads: Mutex<Vec<JoinHandle<()>>>,
+    queues: Mutex<HashMap<String, Arc<TrackQueue>>>,
+    batching: SharedBatching,
+}
+
+impl DeliveryExecutor {
+    pub fn new(threads: usize) -> Self {
+        let (ready_tx, ready_rx) = mpsc::channel();
+
+        Self {
+            ready_tx,
+            ready_rx: Arc::new(Mutex::new(ready_rx)),
+            thread_count: threads.max(1),
+            threads: Mutex::new(Vec::new()),
+            queues: Mutex::new(HashMap::new()),
+            batching: Arc::new(RwLock::new(None)),
+        }
+    }
+
+    /// Start the delivery threads, once the first track is queued
+    fn start(&self) {
+        let mut threads = self.threads.lock().unwrap_or_else(|e| e.into_inner());
+        if !threads.is_empty() {
+            return;
+        }
+        for index in 0..self.thread_count {
+            let ready_rx = self.ready_rx.clone();
+            let spawned = std::thread::Builder::new()
+                .name(format!("moq-delivery-{}", index))
+                .spawn(move || loop {
+                    let next = match ready_rx.lock() {
+                        Ok(ready_rx) => ready_rx.recv(),
+                        Err(_) => return,
+                    };
+                    match next {
+                        Ok(Some(queue)) => queue.drain(),
+                        Ok(None) | Err(_) => return,
+                    }
+                });
+            match spawned {
+                Ok(handle) => threads.push(handle),
+                Err(e) => warn!("Failed to start delivery thread: {}", e),
+            }
+        }
+        debug!("Started {} delivery threads", threads.len());
+    }
+
+    fn entry(&self, track_name: &str) -> Arc<TrackQueue> {
+        let mut queues = self.queues.lock().unwrap_or_else(|e| e.into_inner());
+        queues
+            .entry(track_name.to_string())
+            .or_insert_with(|| {
+                Arc::new(TrackQueue {
+                    track_name: track_name.to_string(),
+                    state: Mutex::new(QueueState {
+                        mode: DeliveryMode::default(),
+                        frames: VecDeque::new(),
+                        scheduled: false,
+                        flush_pending: false,
+                        receivers: None,
+                        stats: DeliveryStats::default(),
+                    }),
+                    space: Notify::new(),
+                    ready_tx: self.ready_tx.clone(),
+                    batching: self.batching.clone(),
+                })
+            })
+            .clone()
+    }
+
+    /// Queue of a track, delivering to `receivers`
+    pub fn queue(&self, track_name: &str, receivers: FrameReceivers) -> Arc<TrackQueue> {
+        let queue = self.entry(track_name);
+        if let Ok(mut state) = queue.state.lock() {
+            state.receivers = Some(receivers);
+        }
+        queue
+    }
+
+    pub fn set_mode(&self, track_name: &str, mode: DeliveryMode) {
+        if matches!(mode, DeliveryMode::Queued { .. }) {
+            self.start();
+        }
+        let queue = self.entry(track_name);
+        if let Ok(mut state) = queue.state.lock() {
+            state.mode = mode;
+        }
+        // Wake a reader blocked on a full queue; it re-checks the new mode
+        queue.space.notify_one();
+    }
+
+    /// Hand frames of every track to a batch callback, or back to one call per frame
+    pub fn set_batching(&self, batching: Option<FrameBatching>) {
+        if let Ok(mut current) = self.batching.write() {
+            *current = batching;
+        }
+        // Release frames held back for a batch that will no longer fill
+        let queues = self.queues.lock().unwrap_or_else(|e| e.into_inner());
+        for queue in queues.values() {
+            queue.flush();
+        }
+    }
+
+    pub fn stats(&self, track_name: &str) -> Option<DeliveryStats> {
+        let queues = self.queues.lock().ok()?;
+        queues.get(track_name).map(|queue| queue.stats())
+    }
+}
+
+impl Drop for DeliveryExecutor {
+    fn drop(&mut self) {
+        let threads = std::mem::take(self.threads.get_mut().unwrap_or_else(|e| e.into_inner()));
+        // Track queues keep senders alive, so stop each thread explicitly
+        for _ in &threads {
+            let _ = self.ready_tx.send(None);
+        }
+        let current = std::thread::current().id();
+        for handle in threads {
+            // A callback dropping the last session reference runs on a delivery thread
+            if handle.thread().id() != current {
+                let _ = handle.join();
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::frame::{FrameCallback, FrameInfo};
+    use crate::subscription_manager::TrackDataCallback;
+    use bytes::Bytes;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use tokio::sync::RwLock;
+
+    fn receivers(callback: TrackDataCallback) -> FrameReceivers {
+        FrameReceivers {
+            data: Arc::new(RwLock::new(Some(callback))),
+            frame: Arc::new(RwLock::new(None::<FrameCallback>)),
+            track: Arc::new(RwLock::new(None)),
+        }
+    }
+
+    const QUEUED: DeliveryMode = DeliveryMode::Queued {
+        capacity: 256,
+        overflow: OverflowPolicy::Block,
+    };
+
+    fn frame(index: u8) -> ReceivedFrame {
+        ReceivedFrame {
+            info: FrameInfo {
+                track_id: 0,
+                group_sequence: 0,
+                frame_index: index.into(),
+                end_of_group: false,
+                arrival: Instant::now(),
+            },
+            data: Bytes::from(vec![index]),
+        }
+    }
+
+    #[test]
+    fn test_histogram() {
+        let mut histogram = Histogram::default();
+        for value in [0, 1, 3, 900, 1000] {
+            histogram.record(value);
+        }
+        assert_eq!(histogram.count(), 5);
+        assert_eq!(histogram.percentile(20.0), 0);
+        assert_eq!(histogram.percentile(60.0), 3);
+        assert_eq!(histogram.percentile(100.0), 1023);
+    }
+
+    #[tokio::test]
+    async fn test_delivery_order_and_overflow() {
+        let executor = DeliveryExecutor::new(2);
+        let received = Arc::new(Mutex::new(Vec::new()));
+        let sink = received.clone();
+        let callback: TrackDataCallback = Arc::new(move |_track, data| {
+            sink.lock().unwrap().push(data[0]);
+        });
+        executor.set_mode("video", QUEUED);
+        let queue = executor.queue("video", receivers(callback));
+
+        for i in 0..100u8 {
+            queue.push(frame(i)).await;
+        }
+        while executor.stats("video").unwrap().delivered < 100 {
+            tokio::task::yield_now().await;
+        }
+        assert_eq!(*received.lock().unwrap(), (0..100u8).collect::<Vec<_>>());
+
+        // A stalled callback with a one-frame queue drops the newest frames
+        let calls = Arc::new(AtomicUsize::new(0));
+        let counter = calls.clone();
+        let slow: TrackDataCallback = Arc::new(move |_track, _data| {
+            counter.fetch_add(1, Ordering::SeqCst);
+            std::thread::sleep(Duration::from_millis(50));
+        });
+        executor.set_mode(
+            "thumbnail",
+            DeliveryMode::Queued {
+                capacity: 1,
+                overflow: OverflowPolicy::DropNewest,
+            },
+        );
+        let queue = executor.queue("thumbnail", receivers(slow));
+        for i in 0..10u8 {
+            queue.push(frame(i)).await;
+        }
+        assert!(executor.stats("thumbnail").unwrap().dropped > 0);
+    }
+
+    #[tokio::test]
+    async fn test_batched_delivery() {
+        let executor = DeliveryExecutor::new(1);
+        let batches = Arc::new(Mutex::new(Vec::new()));
+        let sink = batches.clone();
+        executor.set_batching(Some(FrameBatching {
+            callback: Arc::new(move |_track, frames| {
+                let indices: Vec<u8> = frames.iter().map(|frame| frame.data[0]).collect();
+                sink.lock().unwrap().push(indices);
+            }),
+            max_frames: 4,
+            max_delay: Duration::from_millis(20),
+        }));
+        executor.set_mode("telemetry", QUEUED);
+        let queue = executor.queue("telemetry", receivers(Arc::new(|_track, _data| {})));
+
+        // Full batches go out at once, the remainder when the delay runs out
+        for i in 0..10u8 {
+            queue.push(frame(i)).await;
+        }
+        while executor.stats("telemetry").unwrap().delivered < 10 {
+            tokio::time::sleep(Duration::from_millis(1)).await;
+        }
+        let batches = batches.lock().unwrap();
+        assert!(batches.iter().all(|batch| batch.len() <= 4));
+        assert!(batches.len() < 10);
+        assert_eq!(batches.concat(), (0..10u8).collect::<Vec<_>>());
+    }
+
+    #[tokio::test]
+    async fn test_threads_start_when_queued_and_join_on_drop() {
+        let executor = DeliveryExecutor::new(2);
+        let callback: TrackDataCallback = Arc::new(|_track, _data| {});
+        let queue = executor.queue("video", receivers(callback));
+        queue.push(frame(0)).await;
+        assert!(executor.threads.lock().unwrap().is_empty());
+
+        executor.set_mode("video", QUEUED);
+        queue.push(frame(1)).await;
+        assert_eq!(executor.threads.lock().unwrap().len(), 2);
+
+        // The queue outlives the executor and still holds a sender
+        let ready_rx = Arc::downgrade(&executor.ready_rx);
+        let (done_tx, done_rx) = mpsc::channel();
+        std::thread::spawn(move || {
+            drop(executor);
+            let _ = done_tx.send(());
+        });
+        done_rx
+            .recv_timeout(Duration::from_secs(1))
+            .expect("dropping the executor stops its threads");
+        // Joined threads no longer hold the receiver
+        assert!(ready_rx.upgrade().is_none());
+        drop(queue);
+    }
+}
@@ -6,9 +6,13 @@ use tokio::runtime::Runtime;
 use tracing::{info, Level};
 
 use crate::{
-    close_session, create_publisher, create_subscriber, publish_data, set_data_callback,
-    set_log_level, write_frame, write_single_frame, CatalogType, MoqSession, TrackDefinition,
-    TrackType,
+    add_track, close_session, create_publisher, create_subscriber, frame::monotonic_micros,
+    publish_data, remove_track, set_data_callback, set_log_level, set_track_filters,
+    start_publisher, write_frame, write_frames, write_single_frame, BufferProvider, Bytes,
+    CatalogCallback, CatalogSnapshot, CatalogType, DeliveryMode, FrameBatchCallback, FrameBatching,
+    FrameCallback, FrameChunk, FrameInfo, FrameSpec, FrameWriter, JitterConfig, LatencyPolicy,
+    MoqSession, OverflowPolicy, ProvidedBuffer, ReceivedFrame, StartPosition, TimestampFormat,
+    TrackDefinition, TrackFilter, TrackType,
 };
 
 // Opaque handles for C API
@@ -19,14 +23,197 @@ pub struct CMoqSession {
     broadcast_announced_callback: Arc<RwLock<Option<CBroadcastAnnouncedCallback>>>,
     broadcast_cancelled_callback: Arc<RwLock<Option<CBroadcastCancelledCallback>>>,
     connection_closed_callback: Arc<RwLock<Option<CConnectionClosedCallback>>>,
+    catalog_callback: Arc<RwLock<Option<CCatalogCallback>>>,
+    groups_skipped_callback: Arc<RwLock<Option<CGroupsSkippedCallback>>>,
+    frame_callback: Arc<RwLock<Option<CFrameCallback>>>,
+    data_view_callback: Arc<RwLock<Option<CDataViewCallback>>>,
+    frame_batch_callback: Arc<RwLock<Option<CFrameBatchCallback>>>,
+    chunk_callback: Arc<RwLock<Option<CChunkCallback>>>,
+    buffer_provider: Arc<RwLock<Option<(CProvideBufferCallback, CBufferCompleteCallback)>>>,
+}
+
+impl CMoqSession {
+    fn new(session: Arc<MoqSession>, runtime: Arc<Runtime>) -> Self {
+        Self {
+            session,
+            runtime,
+            data_callback: Arc::new(RwLock::new(None)),
+            broadcast_announced_callback: Arc::new(RwLock::new(None)),
+            broadcast_cancelled_callback: Arc::new(RwLock::new(None)),
+            connection_closed_callback: Arc::new(RwLock::new(None)),
+            catalog_callback: Arc::new(RwLock::new(None)),
+            groups_skipped_callback: Arc::new(RwLock::new(None)),
+            frame_callback: Arc::new(RwLock::new(None)),
+            data_view_callback: Arc::new(RwLock::new(None)),
+            frame_batch_callback: Arc::new(RwLock::new(None)),
+            chunk_callback: Arc::new(RwLock::new(None)),
+            buffer_provider: Arc::new(RwLock::new(None)),
+        }
+    }
+}
+
+/// Opaque handle to an immutable catalog snapshot
+pub struct CCatalog {
+    snapshot: Arc<CatalogSnapshot>,
+}
+
+/// Opaque handle to a frame being streamed in chunks
+pub struct CFrameWriter {
+    writer: FrameWriter,
+}
+
+/// Track entry of a catalog snapshot; `name` is not NUL-terminated and stays valid
+/// until the owning `CCatalog` is freed
+#[repr(C)]
+pub struct CCatalogTrack {
+    name: *const c_char,
+    name_len: usize,
+    priority: u32,
+    track_type: u8,
 }
 
 // C-compatible struct for passing track definitions
+//
+// start_mode: 0 any, 1 latest group, 2 from group `start_value`, 3 newest `start_value` groups
 #[repr(C)]
 pub struct CTrackDefinitionFFI {
     name: *const c_char,
     priority: u32,
     track_type: u8,
+    start_mode: u8,
+    start_value: u64,
+}
+
+impl CTrackDefinitionFFI {
+    fn start_position(&self) -> StartPosition {
+        match self.start_mode {
+            1 => StartPosition::Latest,
+            2 => StartPosition::Group(self.start_value),
+            3 => StartPosition::Newest(self.start_value.try_into().unwrap_or(usize::MAX)),
+            _ => StartPosition::Any,
+        }
+    }
+}
+
+// C-compatible jitter buffer settings
+#[repr(C)]
+pub struct CJitterConfig {
+    target_delay_ms: u32,
+    max_delay_ms: u32,
+    adaptive: u8,
+    drop_late: u8,
+    timestamp_format: u8,
+}
+
+// C-compatible jitter buffer statistics
+#[repr(C)]
+pub struct CJitterStats {
+    occupancy: usize,
+    delay_us: u64,
+    jitter_us: u64,
+    late_frames: u64,
+    underruns: u64,
+    released: u64,
+}
+
+// C-compatible frame metadata; arrival_us is on the clock of `moq_monotonic_time_us`
+#[repr(C)]
+pub struct CFrameInfo {
+    track_id: u32,
+    group_sequence: u64,
+    frame_index: u64,
+    end_of_group: u8,
+    arrival_us: u64,
+}
+
+// C-compatible position of a received chunk within its frame
+#[repr(C)]
+pub struct CFrameChunk {
+    track_id: u32,
+    group_sequence: u64,
+    frame_index: u64,
+    frame_size: u64,
+    offset: u64,
+    is_last: u8,
+    error: u8,
+}
+
+// C-compatible frame of a batch; data is only valid during the batch callback
+#[repr(C)]
+pub struct CFrameView {
+    info: CFrameInfo,
+    data: *const u8,
+    size: usize,
+}
+
+impl From<&FrameInfo> for CFrameInfo {
+    fn from(info: &FrameInfo) -> Self {
+        CFrameInfo {
+            track_id: info.track_id,
+            group_sequence: info.group_sequence,
+            frame_index: info.frame_index,
+            end_of_group: info.end_of_group as u8,
+            arrival_us: info.arrival_micros(),
+        }
+    }
+}
+
+// C-compatible frame to publish
+#[repr(C)]
+pub struct CFrameSpec {
+    data: *const u8,
+    size: usize,
+    new_group: bool,
+}
+
+// C-compatible part of a frame; laid out like POSIX iovec
+#[repr(C)]
+pub struct CFramePart {
+    data: *const u8,
+    size: usize,
+}
+
+// Caller-owned memory a frame is read into; handed back through the completion callback
+struct ForeignBuffer {
+    data: *mut u8,
+    capacity: usize,
+}
+
+// The provider hands the buffer over until completion
+unsafe impl Send for ForeignBuffer {}
+
+impl AsMut<[u8]> for ForeignBuffer {
+    fn as_mut(&mut self) -> &mut [u8] {
+        unsafe { std::slice::from_raw_parts_mut(self.data, self.capacity) }
+    }
+}
+
+// C-compatible group sequence counters
+#[repr(C)]
+pub struct CSequenceStats {
+    groups: u64,
+    missing_groups: u64,
+    out_of_order_groups: u64,
+    duplicate_groups: u64,
+}
+
+// C-compatible delivery statistics; percentiles are bucket upper bounds
+#[repr(C)]
+pub struct CDeliveryStats {
+    delivered: u64,
+    dropped: u64,
+    queue_depth_p50: u64,
+    queue_depth_p99: u64,
+    callback_p50_us: u64,
+    callback_p99_us: u64,
+}
+
+// C-compatible track filter; negative or null fields match anything
+#[repr(C)]
+pub struct CTrackFilter {
+    track_type: c_int,
+    name_glob: *const c_char,
+    max_priority: i64,
 }
 
 // Keep the old struct for backward compatibility
@@ -76,6 +263,30 @@ pub type CDataCallback = extern "C" fn(*mut CMoqSession, *const c_char, *const u
 pub type CBroadcastAnnouncedCallback = extern "C" fn(*const c_char);
 pub type CBroadcastCancelledCallback = extern "C" fn(*const c_char);
 pub type CConnectionClosedCallback = extern "C" fn(*mut std::ffi::c_void, *const c_char);
+/// Receives ownership of the catalog handle; release it with `moq_catalog_free`
+pub type CCatalogCallback = extern "C" fn(*mut std::ffi::c_void, *mut CCatalog);
+pub type CGroupsSkippedCallback = extern "C" fn(*mut std::ffi::c_void, *const c_char, u64);
+pub type CFrameCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, *const CFrameInfo, *const u8, usize);
+/// Receives the track name as pointer and length (not NUL-terminated), then the data
+pub type CDataViewCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, usize, *const u8, usize);
+/// Receives the subscription's user data; the frame info carries the track id
+pub type CTrackFrameCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const CFrameInfo, *const u8, usize);
+/// Completes an asynchronous call with its user data and 0 on success, -1 on failure
+pub type CCompletionCallback = extern "C" fn(*mut std::ffi::c_void, c_int);
+/// Receives its user data and the reason the connection closed
+pub type CClosedCallback = extern "C" fn(*mut std::ffi::c_void, *const c_char);
+pub type CChunkCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, *const CFrameChunk, *const u8, usize);
+/// Returns a buffer of at least the given size and stores its capacity, or null to decline
+pub type CProvideBufferCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, u64, *mut usize) -> *mut u8;
+pub type CBufferCompleteCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, *const CFrameInfo, *mut u8, usize);
+pub type CFrameBatchCallback =
+    extern "C" fn(*mut std::ffi::c_void, *const c_char, *const CFrameView, usize);
 
 impl From<CLogLevel> for Level {
     fn from(level: CLogLevel) -> Self {
@@ -189,6 +400,43 @@ pub unsafe extern "C" fn moq_create_publisher(
     tracks: *const CTrackDefinitionFFI,
     track_count: usize,
     catalog_type: CCatalogType,
+) -> *mut CMoqSession {
+    unsafe { new_publisher(url, broadcast_name, tracks, track_count, catalog_type, true) }
+}
+
+/// Create a publisher session and start connecting, without waiting for the connection
+///
+/// See `moq_session_when_connected`.
+///
+/// # Safety
+/// Same as `moq_create_publisher`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_start_publisher(
+    url: *const c_char,
+    broadcast_name: *const c_char,
+    tracks: *const CTrackDefinitionFFI,
+    track_count: usize,
+    catalog_type: CCatalogType,
+) -> *mut CMoqSession {
+    unsafe {
+        new_publisher(
+            url,
+            broadcast_name,
+            tracks,
+            track_count,
+            catalog_type,
+            false,
+        )
+    }
+}
+
+unsafe fn new_publisher(
+    url: *const c_char,
+    broadcast_name: *const c_char,
+    tracks: *const CTrackDefinitionFFI,
+    track_count: usize,
+    catalog_type: CCatalogType,
+    wait_connected: bool,
 ) -> *mut CMoqSession {
     if url.is_null() || broadcast_name.is_null() {
         return ptr::null_mut();
@@ -249,26 +497,19 @@ pub unsafe extern "C" fn moq_create_publisher(
         Err(_) => return ptr::null_mut(),
     };
 
-    let session = match runtime.block_on(create_publisher(
-        url_str,
-        broadcast_str,
-        track_defs,
-        CatalogType::from(catalog_type),
-    )) {
+    let catalog_type = CatalogType::from(catalog_type);
+    let session = match runtime.block_on(async {
+        if wait_connected {
+            create_publisher(url_str, broadcast_str, track_defs, catalog_type).await
+        } else {
+            start_publisher(url_str, broadcast_str, track_defs, catalog_type).await
+        }
+    }) {
         Ok(s) => Arc::new(s),
         Err(_) => return ptr::null_mut(),
     };
 
-    let c_session = CMoqSession {
-        session,
-        runtime,
-        data_callback: Arc::new(RwLock::new(None)),
-        broadcast_announced_callback: Arc::new(RwLock::new(None)),
-        broadcast_cancelled_callback: Arc::new(RwLock::new(None)),
-        connection_closed_callback: Arc::new(RwLock::new(None)),
-    };
-
-    Box::into_raw(Box::new(c_session))
+    Box::into_raw(Box::new(CMoqSession::new(session, runtime)))
 }
 
 /// Create a subscriber session
@@ -331,11 +572,14 @@ pub unsafe extern "C" fn moq_create_subscriber(
                 i, name_str, track_ffi.priority, track_ffi.track_type
             );
 
-            result.push(TrackDefinition::new(
-                name_str,
-                track_ffi.priority,
-                TrackType::from(CTrackType::from(track_ffi.track_type)),
-            ));
+            result.push(
+                TrackDefinition::new(
+                    name_str,
+                    track_ffi.priority,
+                    TrackType::from(CTrackType::from(track_ffi.track_type)),
+                )
+                .with_start(track_ffi.start_position()),
+            );
         }
         result
     } else {
@@ -357,16 +601,7 @@ pub unsafe extern "C" fn moq_create_subscriber(
         Err(_) => return ptr::null_mut(),
     };
 
-    let c_session = CMoqSession {
-        session,
-        runtime,
-        data_callback: Arc::new(RwLock::new(None)),
-        broadcast_announced_callback: Arc::new(RwLock::new(None)),
-        broadcast_cancelled_callback: Arc::new(RwLock::new(None)),
-        connection_closed_callback: Arc::new(RwLock::new(None)),
-    };
-
-    Box::into_raw(Box::new(c_session))
+    Box::into_raw(Box::new(CMoqSession::new(session, runtime)))
 }
 
 /// Set data callback for receiving data
@@ -544,231 +779,1831 @@ pub unsafe extern "C" fn moq_write_frame(
     }
 }
 
-/// Check if session is connected
+/// Write a frame to a track named by pointer and length, optionally starting a new group
 ///
-/// # Safety
-///
-/// This function is unsafe because it dereferences the raw `session` pointer.
-/// The caller must ensure that `session` is a valid pointer to a CMoqSession.
-#[no_mangle]
-pub unsafe extern "C" fn moq_is_connected(session: *mut CMoqSession) -> c_int {
-    if session.is_null() {
-        return 0;
-    }
-
-    let session_ref = unsafe { &*session };
-    if session_ref
-        .runtime
-        .block_on(session_ref.session.is_connected())
-    {
-        1
-    } else {
-        0
-    }
-}
-
-/// Close a session
+/// Like `moq_write_frame`, without requiring (or scanning for) a NUL terminator.
 ///
 /// # Safety
-///
-/// This function is unsafe because it dereferences the raw `session` pointer.
-/// The caller must ensure that `session` is a valid pointer to a CMoqSession.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` points to `track_name_len` bytes of UTF-8
+/// - `data` points to a valid buffer of at least `data_len` bytes
 #[no_mangle]
-pub unsafe extern "C" fn moq_close_session(session: *mut CMoqSession) -> c_int {
-    if session.is_null() {
+pub unsafe extern "C" fn moq_write_frame_n(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    track_name_len: usize,
+    data: *const u8,
+    data_len: usize,
+    new_group: bool,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || data.is_null() {
         return -1;
     }
 
     let session_ref = unsafe { &*session };
-    match session_ref
-        .runtime
-        .block_on(close_session(&session_ref.session))
-    {
+    let Some(track_str) = (unsafe { str_from_raw(track_name, track_name_len) }) else {
+        return -1;
+    };
+
+    let data_slice = unsafe { std::slice::from_raw_parts(data, data_len) };
+    match session_ref.runtime.block_on(write_frame(
+        &session_ref.session,
+        track_str,
+        data_slice.to_vec(),
+        new_group,
+    )) {
         Ok(()) => 0,
         Err(_) => -1,
     }
 }
 
-/// Free a session
-///
-/// # Safety
+/// UTF-8 string of `len` bytes at `ptr`, which need not be NUL-terminated
+unsafe fn str_from_raw<'a>(ptr: *const c_char, len: usize) -> Option<&'a str> {
+    let bytes = unsafe { std::slice::from_raw_parts(ptr as *const u8, len) };
+    std::str::from_utf8(bytes).ok()
+}
+
+/// Write a frame on the session's runtime and report the outcome to `callback`
 ///
-/// This function is unsafe because it takes ownership of a raw pointer.
-/// Set a log callback for a specific session to receive session-specific log messages
+/// The data is copied before this returns, so the caller's buffer can be reused at once;
+/// the calling thread never waits on the runtime. Writes in flight together may land in
+/// any order; start the next one from `callback` to keep them in sequence. `callback`
+/// runs on a library thread, and is never called if the session is freed first.
 ///
 /// # Safety
-/// The caller must ensure that `session` was previously allocated by
-/// `moq_create_publisher` or `moq_create_subscriber` and has not been freed before.
-/// The callback function pointer must be valid for the lifetime of the session.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` is a valid null-terminated C string
+/// - `data` points to a valid buffer of at least `data_len` bytes
+/// - `user_data` stays valid until `callback` runs
 #[no_mangle]
-pub unsafe extern "C" fn moq_session_set_log_callback(
+pub unsafe extern "C" fn moq_write_frame_async(
     session: *mut CMoqSession,
-    callback: Option<CLogCallback>,
-) -> MoqResult {
-    if session.is_null() {
-        return MoqResult::InvalidArgument;
+    track_name: *const c_char,
+    data: *const u8,
+    data_len: usize,
+    new_group: bool,
+    callback: CCompletionCallback,
+    user_data: *mut std::ffi::c_void,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || data.is_null() {
+        return -1;
     }
 
     let session_ref = unsafe { &*session };
 
-    if let Some(callback) = callback {
-        let callback_wrapper = move |target: &str, level: Level, message: &str| {
-            let target_cstr = CString::new(target).unwrap_or_default();
-            let message_cstr = CString::new(message).unwrap_or_default();
-            let level_int = match level {
-                Level::TRACE => 0,
-                Level::DEBUG => 1,
-                Level::INFO => 2,
-                Level::WARN => 3,
-                Level::ERROR => 4,
-            };
-            callback(target_cstr.as_ptr(), level_int, message_cstr.as_ptr());
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s.to_string(),
+            Err(_) => return -1,
+        }
+    };
+
+    let data_vec = unsafe { std::slice::from_raw_parts(data, data_len) }.to_vec();
+    let session = session_ref.session.clone();
+    let user_data = user_data as usize;
+    let write = async move {
+        let result = match write_frame(&session, &track_str, data_vec, new_group).await {
+            Ok(()) => 0,
+            Err(_) => -1,
         };
+        callback(user_data as *mut std::ffi::c_void, result);
+    };
+    session_ref.runtime.spawn(write);
 
-        session_ref.runtime.block_on(
-            session_ref
-                .session
-                .set_log_callback(Some(Box::new(callback_wrapper))),
-        );
-        MoqResult::Success
-    } else {
-        session_ref
-            .runtime
-            .block_on(session_ref.session.set_log_callback(None));
-        MoqResult::Success
-    }
+    0
 }
 
-/// Free a MoQ session and its resources
+/// Write a frame gathered from several parts, optionally starting a new group
 ///
-/// Set broadcast announced callback
+/// The parts are copied once, straight into the frame's buffer, so a header and payload
+/// need not be joined by the caller first.
 ///
 /// # Safety
-/// The caller must ensure that `session` is a valid pointer returned from
-/// `moq_create_publisher` or `moq_create_subscriber`.
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` is a valid null-terminated C string
+/// - `parts` points to `count` parts, each with `data` valid for `size` bytes
 #[no_mangle]
-pub unsafe extern "C" fn moq_session_set_broadcast_announced_callback(
+pub unsafe extern "C" fn moq_write_frame_parts(
     session: *mut CMoqSession,
-    callback: CBroadcastAnnouncedCallback,
+    track_name: *const c_char,
+    parts: *const CFramePart,
+    count: usize,
+    new_group: bool,
 ) -> c_int {
-    if session.is_null() {
-        return MoqResult::InvalidArgument as c_int;
+    if session.is_null() || track_name.is_null() || (parts.is_null() && count > 0) {
+        return -1;
     }
 
     let session_ref = unsafe { &*session };
 
-    // Store the C callback
-    if let Ok(mut cb) = session_ref.broadcast_announced_callback.write() {
-        *cb = Some(callback);
-    }
-
-    // Set up the Rust callback that will call the C callback
-    let c_callback = session_ref.broadcast_announced_callback.clone();
-    let rust_callback = Box::new(move |path: &str| {
-        if let Ok(guard) = c_callback.read() {
-            if let Some(cb) = *guard {
-                let c_path = CString::new(path).unwrap_or_else(|_| CString::new("").unwrap());
-                cb(c_path.as_ptr());
-            }
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s,
+            Err(_) => return -1,
         }
-    });
+    };
 
-    // Set the callback in the session
-    session_ref.runtime.block_on(async {
-        session_ref
-            .session
-            .set_broadcast_announced_callback(rust_callback)
-            .await;
-    });
+    let parts = if count == 0 {
+        &[][..]
+    } else {
+        unsafe { std::slice::from_raw_parts(parts, count) }
+    };
+    if parts
+        .iter()
+        .any(|part| part.data.is_null() && part.size > 0)
+    {
+        return -1;
+    }
 
-    MoqResult::Success as c_int
+    // The caller's buffers are borrowed, so they can't be chained; gather them in one copy
+    let mut data_vec = Vec::with_capacity(parts.iter().map(|part| part.size).sum());
+    for part in parts.iter().filter(|part| part.size > 0) {
+        data_vec.extend_from_slice(unsafe { std::slice::from_raw_parts(part.data, part.size) });
+    }
+
+    match session_ref.runtime.block_on(write_frame(
+        &session_ref.session,
+        track_str,
+        data_vec,
+        new_group,
+    )) {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Start a frame of `total_size` bytes, to be streamed with `moq_frame_writer_append`
+///
+/// Chunks are sent as they are appended, so a large frame is never buffered whole.
+/// Returns null on failure. The writer must be passed to `moq_frame_writer_finish` or
+/// `moq_frame_writer_free`.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_frame_writer_begin(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    total_size: u64,
+    new_group: bool,
+) -> *mut CFrameWriter {
+    if session.is_null() || track_name.is_null() {
+        return ptr::null_mut();
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s,
+            Err(_) => return ptr::null_mut(),
+        }
+    };
+
+    let writer = session_ref.runtime.block_on(async {
+        if new_group {
+            session_ref.session.start_group(track_str).await?;
+        }
+        session_ref.session.begin_frame(track_str, total_size).await
+    });
+
+    match writer {
+        Ok(writer) => Box::into_raw(Box::new(CFrameWriter { writer })),
+        Err(_) => ptr::null_mut(),
+    }
+}
+
+/// Send the next chunk of a streamed frame
+///
+/// Returns -1 if the chunk would exceed the frame's total size.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `writer` is a valid pointer returned from `moq_frame_writer_begin`
+/// - `data` points to a valid buffer of at least `data_len` bytes
+#[no_mangle]
+pub unsafe extern "C" fn moq_frame_writer_append(
+    writer: *mut CFrameWriter,
+    data: *const u8,
+    data_len: usize,
+) -> c_int {
+    if writer.is_null() || (data.is_null() && data_len > 0) {
+        return -1;
+    }
+
+    let writer_ref = unsafe { &mut *writer };
+    let chunk = if data_len == 0 {
+        Bytes::new()
+    } else {
+        Bytes::copy_from_slice(unsafe { std::slice::from_raw_parts(data, data_len) })
+    };
+
+    match writer_ref.writer.append(chunk) {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Complete a streamed frame and release the writer
+///
+/// Returns -1, abandoning the frame, if fewer than `total_size` bytes were appended.
+///
+/// # Safety
+/// The caller must ensure that `writer` was returned from `moq_frame_writer_begin` and has
+/// not been finished or freed before.
+#[no_mangle]
+pub unsafe extern "C" fn moq_frame_writer_finish(writer: *mut CFrameWriter) -> c_int {
+    if writer.is_null() {
+        return -1;
+    }
+
+    let writer = unsafe { Box::from_raw(writer) };
+    match writer.writer.finish() {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Abandon a streamed frame and release the writer
+///
+/// # Safety
+/// The caller must ensure that `writer` was returned from `moq_frame_writer_begin` and has
+/// not been finished or freed before.
+#[no_mangle]
+pub unsafe extern "C" fn moq_frame_writer_free(writer: *mut CFrameWriter) {
+    if !writer.is_null() {
+        unsafe {
+            drop(Box::from_raw(writer));
+        }
+    }
+}
+
+/// Write a run of frames to a track in one call
+/// This corresponds to lib.rs write_frames()
+///
+/// The frames are copied into a single buffer, so the caller's memory can be reused as soon
+/// as this returns.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` is a valid null-terminated C string
+/// - `frames` points to `count` frame specs, each with `data` valid for `size` bytes
+#[no_mangle]
+pub unsafe extern "C" fn moq_write_frames(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    frames: *const CFrameSpec,
+    count: usize,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || (frames.is_null() && count > 0) {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s,
+            Err(_) => return -1,
+        }
+    };
+
+    let specs = if count == 0 {
+        &[][..]
+    } else {
+        unsafe { std::slice::from_raw_parts(frames, count) }
+    };
+    if specs
+        .iter()
+        .any(|spec| spec.data.is_null() && spec.size > 0)
+    {
+        return -1;
+    }
+
+    // One allocation for the whole run; each frame is a slice of it
+    let total = specs.iter().map(|spec| spec.size).sum();
+    let mut buffer = Vec::with_capacity(total);
+    for spec in specs.iter().filter(|spec| spec.size > 0) {
+        buffer.extend_from_slice(unsafe { std::slice::from_raw_parts(spec.data, spec.size) });
+    }
+    let buffer = Bytes::from(buffer);
+    let mut offset = 0;
+    let frame_specs = specs
+        .iter()
+        .map(|spec| {
+            let data = buffer.slice(offset..offset + spec.size);
+            offset += spec.size;
+            FrameSpec {
+                data,
+                new_group: spec.new_group,
+            }
+        })
+        .collect();
+
+    match session_ref
+        .runtime
+        .block_on(write_frames(&session_ref.session, track_str, frame_specs))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Add a track to a live publisher session and republish the catalog
+/// This corresponds to lib.rs add_track()
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_add_track(
+    session: *mut CMoqSession,
+    name: *const c_char,
+    priority: u32,
+    track_type: u8,
+) -> c_int {
+    if session.is_null() || name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let name_str = unsafe {
+        match CStr::from_ptr(name).to_str() {
+            Ok(s) => s,
+            Err(_) => return -1,
+        }
+    };
+
+    let track_def = TrackDefinition::new(
+        name_str,
+        priority,
+        TrackType::from(CTrackType::from(track_type)),
+    );
+
+    match session_ref
+        .runtime
+        .block_on(add_track(&session_ref.session, track_def))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Remove a track from a live publisher session and republish the catalog
+/// This corresponds to lib.rs remove_track()
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers.
+/// The caller must ensure that:
+/// - `session` is a valid pointer to a CMoqSession
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_remove_track(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s,
+            Err(_) => return -1,
+        }
+    };
+
+    match session_ref
+        .runtime
+        .block_on(remove_track(&session_ref.session, track_str))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Stop receiving a subscribed track; its settings and statistics are kept for a fast resume
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_pause_track(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.pause_track(track_name))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Subscribe again to a track stopped with `moq_session_pause_track`
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_resume_track(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.resume_track(track_name))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Subscribe to every catalog track matching any of the filters
+///
+/// Subscriptions follow catalog updates; an empty list (`filter_count == 0`) clears them.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers passed from C.
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `filters` points to `filter_count` valid filters (or is null when the count is 0)
+/// - each non-null `name_glob` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_track_filters(
+    session: *mut CMoqSession,
+    filters: *const CTrackFilter,
+    filter_count: usize,
+) -> c_int {
+    if session.is_null() || (filters.is_null() && filter_count > 0) {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let mut track_filters = Vec::with_capacity(filter_count);
+    if filter_count > 0 {
+        for filter in unsafe { std::slice::from_raw_parts(filters, filter_count) } {
+            let mut track_filter = TrackFilter::any();
+            if filter.track_type >= 0 {
+                track_filter = track_filter
+                    .with_type(TrackType::from(CTrackType::from(filter.track_type as u8)));
+            }
+            if !filter.name_glob.is_null() {
+                match unsafe { CStr::from_ptr(filter.name_glob).to_str() } {
+                    Ok(glob) => track_filter = track_filter.with_name_glob(glob),
+                    Err(_) => return -1,
+                }
+            }
+            if filter.max_priority >= 0 {
+                track_filter = track_filter
+                    .with_max_priority(filter.max_priority.try_into().unwrap_or(u32::MAX));
+            }
+            track_filters.push(track_filter);
+        }
+    }
+
+    match session_ref
+        .runtime
+        .block_on(set_track_filters(&session_ref.session, track_filters))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Check if session is connected
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences the raw `session` pointer.
+/// The caller must ensure that `session` is a valid pointer to a CMoqSession.
+#[no_mangle]
+pub unsafe extern "C" fn moq_is_connected(session: *mut CMoqSession) -> c_int {
+    if session.is_null() {
+        return 0;
+    }
+
+    let session_ref = unsafe { &*session };
+    if session_ref
+        .runtime
+        .block_on(session_ref.session.is_connected())
+    {
+        1
+    } else {
+        0
+    }
+}
+
+/// Call `callback` once the session is connected, without blocking
+///
+/// Completes with 0 when connected (right away if it already is), or -1 if the connection
+/// attempt fails, the connection closes first, or the session is closed while connecting.
+/// Sessions connect once, so -1 is final. Runs on a library thread. Never called if the session is freed
+/// while waiting.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_start_publisher`,
+///   `moq_create_publisher` or `moq_create_subscriber`
+/// - `user_data` stays valid until `callback` runs
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_when_connected(
+    session: *mut CMoqSession,
+    callback: CCompletionCallback,
+    user_data: *mut std::ffi::c_void,
+) -> c_int {
+    if session.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let session = session_ref.session.clone();
+    let user_data = user_data as usize; // Convert to usize for thread safety
+    session_ref.runtime.spawn(async move {
+        let result = match session.connected().await {
+            Ok(()) => 0,
+            Err(_) => -1,
+        };
+        callback(user_data as *mut std::ffi::c_void, result);
+    });
+
+    0
+}
+
+/// Call `callback` with the reason once the session's connection closes, without blocking
+///
+/// Runs on a library thread; the reason is only valid during the call. Never called if
+/// the session is freed while waiting.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_start_publisher`,
+///   `moq_create_publisher` or `moq_create_subscriber`
+/// - `user_data` stays valid until `callback` runs
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_when_closed(
+    session: *mut CMoqSession,
+    callback: CClosedCallback,
+    user_data: *mut std::ffi::c_void,
+) -> c_int {
+    if session.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let session = session_ref.session.clone();
+    let user_data = user_data as usize;
+    session_ref.runtime.spawn(async move {
+        let reason = session.closed().await;
+        let c_reason = CString::new(reason).unwrap_or_else(|_| CString::new("").unwrap());
+        callback(user_data as *mut std::ffi::c_void, c_reason.as_ptr());
+    });
+
+    0
+}
+
+/// Close a session
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences the raw `session` pointer.
+/// The caller must ensure that `session` is a valid pointer to a CMoqSession.
+#[no_mangle]
+pub unsafe extern "C" fn moq_close_session(session: *mut CMoqSession) -> c_int {
+    if session.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    match session_ref
+        .runtime
+        .block_on(close_session(&session_ref.session))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Free a session
+///
+/// # Safety
+///
+/// This function is unsafe because it takes ownership of a raw pointer.
+/// Set a log callback for a specific session to receive session-specific log messages
+///
+/// # Safety
+/// The caller must ensure that `session` was previously allocated by
+/// `moq_create_publisher` or `moq_create_subscriber` and has not been freed before.
+/// The callback function pointer must be valid for the lifetime of the session.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_log_callback(
+    session: *mut CMoqSession,
+    callback: Option<CLogCallback>,
+) -> MoqResult {
+    if session.is_null() {
+        return MoqResult::InvalidArgument;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    if let Some(callback) = callback {
+        let callback_wrapper = move |target: &str, level: Level, message: &str| {
+            let target_cstr = CString::new(target).unwrap_or_default();
+            let message_cstr = CString::new(message).unwrap_or_default();
+            let level_int = match level {
+                Level::TRACE => 0,
+                Level::DEBUG => 1,
+                Level::INFO => 2,
+                Level::WARN => 3,
+                Level::ERROR => 4,
+            };
+            callback(target_cstr.as_ptr(), level_int, message_cstr.as_ptr());
+        };
+
+        session_ref.runtime.block_on(
+            session_ref
+                .session
+                .set_log_callback(Some(Box::new(callback_wrapper))),
+        );
+        MoqResult::Success
+    } else {
+        session_ref
+            .runtime
+            .block_on(session_ref.session.set_log_callback(None));
+        MoqResult::Success
+    }
+}
+
+/// Free a MoQ session and its resources
+///
+/// Set broadcast announced callback
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_publisher` or `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_broadcast_announced_callback(
+    session: *mut CMoqSession,
+    callback: CBroadcastAnnouncedCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.broadcast_announced_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.broadcast_announced_callback.clone();
+    let rust_callback = Box::new(move |path: &str| {
+        if let Ok(guard) = c_callback.read() {
+            if let Some(cb) = *guard {
+                let c_path = CString::new(path).unwrap_or_else(|_| CString::new("").unwrap());
+                cb(c_path.as_ptr());
+            }
+        }
+    });
+
+    // Set the callback in the session
+    session_ref.runtime.block_on(async {
+        session_ref
+            .session
+            .set_broadcast_announced_callback(rust_callback)
+            .await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Set broadcast cancelled callback
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_publisher` or `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_broadcast_cancelled_callback(
+    session: *mut CMoqSession,
+    callback: CBroadcastCancelledCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.broadcast_cancelled_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.broadcast_cancelled_callback.clone();
+    let rust_callback = Box::new(move |path: &str| {
+        if let Ok(guard) = c_callback.read() {
+            if let Some(cb) = *guard {
+                let c_path = CString::new(path).unwrap_or_else(|_| CString::new("").unwrap());
+                cb(c_path.as_ptr());
+            }
+        }
+    });
+
+    // Set the callback in the session
+    session_ref.runtime.block_on(async {
+        session_ref
+            .session
+            .set_broadcast_cancelled_callback(rust_callback)
+            .await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Set connection closed callback
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_publisher` or `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_connection_closed_callback(
+    session: *mut CMoqSession,
+    callback: CConnectionClosedCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.connection_closed_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.connection_closed_callback.clone();
+    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+    let rust_callback = Box::new(move |reason: &str| {
+        if let Ok(guard) = c_callback.read() {
+            if let Some(cb) = *guard {
+                let c_reason = CString::new(reason).unwrap_or_else(|_| CString::new("").unwrap());
+                cb(session_handle as *mut std::ffi::c_void, c_reason.as_ptr());
+            }
+        }
+    });
+
+    // Set the callback in the session
+    session_ref.runtime.block_on(async {
+        session_ref
+            .session
+            .set_connection_closed_callback(rust_callback)
+            .await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Set catalog callback, invoked whenever the subscribed catalog changes
+///
+/// The current catalog, if any, is replayed to the callback on the calling thread outside
+/// the runtime, so the callback may call back into the session.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_publisher` or `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_catalog_callback(
+    session: *mut CMoqSession,
+    callback: CCatalogCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.catalog_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.catalog_callback.clone();
+    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+    let rust_callback: Arc<CatalogCallback> =
+        Arc::new(Box::new(move |snapshot: Arc<CatalogSnapshot>| {
+            if let Ok(guard) = c_callback.read() {
+                if let Some(cb) = *guard {
+                    let catalog = Box::into_raw(Box::new(CCatalog { snapshot }));
+                    cb(session_handle as *mut std::ffi::c_void, catalog);
+                }
+            }
+        }));
+
+    // Set the callback in the session, then replay the current catalog outside the
+    // runtime so the callback may call back into the session
+    let session = &session_ref.session;
+    session_ref
+        .runtime
+        .block_on(session.install_catalog_callback(rust_callback.clone()));
+    let mut delivered = None;
+    while let Some(snapshot) = session_ref
+        .runtime
+        .block_on(session.catalog_to_replay(delivered.as_ref()))
+    {
+        rust_callback(snapshot.clone());
+        delivered = Some(snapshot);
+    }
+
+    MoqResult::Success as c_int
+}
+
+/// Set groups skipped callback, invoked when groups of a track are dropped to catch up
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_publisher` or `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_groups_skipped_callback(
+    session: *mut CMoqSession,
+    callback: CGroupsSkippedCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.groups_skipped_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.groups_skipped_callback.clone();
+    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+    let rust_callback = Box::new(move |track: &str, count: u64| {
+        if let Ok(guard) = c_callback.read() {
+            if let Some(cb) = *guard {
+                let c_track = CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                cb(
+                    session_handle as *mut std::ffi::c_void,
+                    c_track.as_ptr(),
+                    count,
+                );
+            }
+        }
+    });
+
+    // Set the callback in the session
+    session_ref.runtime.block_on(async {
+        session_ref
+            .session
+            .set_groups_skipped_callback(rust_callback)
+            .await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Set frame callback, invoked for every subscribed frame with its metadata
+///
+/// Runs alongside the data callback. The frame info and data are only valid during the call.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_frame_callback(
+    session: *mut CMoqSession,
+    callback: CFrameCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.frame_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set the callback in the session
+    let rust_callback = frame_dispatch(session, session_ref);
+    session_ref.runtime.block_on(async {
+        session_ref.session.set_frame_callback(rust_callback).await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Set data callback receiving the track name as pointer and length
+///
+/// Unlike `moq_session_set_data_callback`, nothing is allocated per frame: the name is
+/// not copied into a C string and the data is not copied. Neither is NUL-terminated nor
+/// valid after the call. Runs alongside the frame callback. A null callback removes it.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_data_view_callback(
+    session: *mut CMoqSession,
+    callback: Option<CDataViewCallback>,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+    if let Ok(mut cb) = session_ref.data_view_callback.write() {
+        *cb = callback;
+    }
+
+    let rust_callback = frame_dispatch(session, session_ref);
+    session_ref.runtime.block_on(async {
+        session_ref.session.set_frame_callback(rust_callback).await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Rust frame callback calling the session's C data view and frame callbacks
+fn frame_dispatch(session: *mut CMoqSession, session_ref: &CMoqSession) -> FrameCallback {
+    let data_view_callback = session_ref.data_view_callback.clone();
+    let frame_callback = session_ref.frame_callback.clone();
+    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+    Arc::new(move |track: &str, info: &FrameInfo, data: &[u8]| {
+        if let Ok(guard) = data_view_callback.read() {
+            if let Some(cb) = *guard {
+                cb(
+                    session_handle as *mut std::ffi::c_void,
+                    track.as_ptr() as *const c_char,
+                    track.len(),
+                    data.as_ptr(),
+                    data.len(),
+                );
+            }
+        }
+        if let Ok(guard) = frame_callback.read() {
+            if let Some(cb) = *guard {
+                let c_track = CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                let c_info = CFrameInfo::from(info);
+                cb(
+                    session_handle as *mut std::ffi::c_void,
+                    c_track.as_ptr(),
+                    &c_info,
+                    data.as_ptr(),
+                    data.len(),
+                );
+            }
+        }
+    })
+}
+
+/// Subscribe to a track with a callback of its own
+///
+/// `callback` receives `user_data` and each frame of the track, without its name; the
+/// frame info's `track_id` equals the id stored in `out_id`. Runs alongside the data and
+/// frame callbacks. The frame info and data are only valid during the call.
+///
+/// Returns -1 if the track already has a subscription or this is not a subscriber.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `out_id` is null or valid for writes
+/// - `user_data` stays valid until `moq_session_unsubscribe_track` returns for the id
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_subscribe_track(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    callback: CTrackFrameCallback,
+    user_data: *mut std::ffi::c_void,
+    out_id: *mut u32,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    let user_data = user_data as usize; // Convert to usize for thread safety
+    let rust_callback = Arc::new(move |info: &FrameInfo, data: &[u8]| {
+        let c_info = CFrameInfo::from(info);
+        callback(
+            user_data as *mut std::ffi::c_void,
+            &c_info,
+            data.as_ptr(),
+            data.len(),
+        );
+    });
+
+    match session_ref.runtime.block_on(
+        session_ref
+            .session
+            .subscribe_track(track_name, rust_callback),
+    ) {
+        Ok(id) => {
+            if !out_id.is_null() {
+                unsafe { *out_id = id };
+            }
+            0
+        }
+        Err(_) => -1,
+    }
+}
+
+/// End a subscription made with `moq_session_subscribe_track`
+///
+/// Waits for a callback in progress; once this returns the callback is not called again,
+/// so it must not be called from the subscription's own callback.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_unsubscribe_track(
+    session: *mut CMoqSession,
+    track_id: u32,
+) -> c_int {
+    if session.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.unsubscribe_track(track_id))
+    {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// End a subscription made with `moq_session_subscribe_track` without blocking
+///
+/// `callback` runs on a library thread once the subscription's callback has returned for
+/// the last time, so it may free the subscription's user data. Safe to call from the
+/// subscription's own callback.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `user_data` stays valid until `callback` runs
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_unsubscribe_track_async(
+    session: *mut CMoqSession,
+    track_id: u32,
+    callback: CCompletionCallback,
+    user_data: *mut std::ffi::c_void,
+) -> c_int {
+    if session.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let session = session_ref.session.clone();
+    let user_data = user_data as usize;
+    session_ref.runtime.spawn(async move {
+        let result = match session.unsubscribe_track(track_id).await {
+            Ok(()) => 0,
+            Err(_) => -1,
+        };
+        callback(user_data as *mut std::ffi::c_void, result);
+    });
+
+    0
+}
+
+/// Set frame batch callback, invoked with up to `max_frames` ready frames of a track at once
+///
+/// A batch is delivered once `max_frames` frames are queued or the oldest has waited
+/// `max_delay_us`; with a zero delay whatever is ready is delivered. Runs on the delivery
+/// threads alongside the data and frame callbacks. A null callback returns to per-frame
+/// delivery. The frame views are only valid during the call.
+///
+/// Returns -1 if the session has no delivery threads.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_frame_batch_callback(
+    session: *mut CMoqSession,
+    callback: Option<CFrameBatchCallback>,
+    max_frames: usize,
+    max_delay_us: u64,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    if let Ok(mut cb) = session_ref.frame_batch_callback.write() {
+        *cb = callback;
+    }
+
+    let batching = callback.map(|_| {
+        let c_callback = session_ref.frame_batch_callback.clone();
+        let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+        let batch_callback: FrameBatchCallback =
+            Arc::new(move |track: &str, frames: &[ReceivedFrame]| {
+                if let Ok(guard) = c_callback.read() {
+                    if let Some(cb) = *guard {
+                        // One track name and one crossing for the whole batch
+                        let c_track =
+                            CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                        let views: Vec<CFrameView> = frames
+                            .iter()
+                            .map(|frame| CFrameView {
+                                info: CFrameInfo::from(&frame.info),
+                                data: frame.data.as_ptr(),
+                                size: frame.data.len(),
+                            })
+                            .collect();
+                        cb(
+                            session_handle as *mut std::ffi::c_void,
+                            c_track.as_ptr(),
+                            views.as_ptr(),
+                            views.len(),
+                        );
+                    }
+                }
+            });
+        FrameBatching {
+            callback: batch_callback,
+            max_frames: max_frames.max(1),
+            max_delay: std::time::Duration::from_micros(max_delay_us),
+        }
+    });
+
+    match session_ref.session.set_frame_batching(batching) {
+        Ok(()) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Set chunk callback, invoked with each piece of a chunked track's frames as it arrives
+///
+/// See `moq_session_set_chunked_delivery`. The chunk info and data are only valid during
+/// the call.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_chunk_callback(
+    session: *mut CMoqSession,
+    callback: CChunkCallback,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    // Store the C callback
+    if let Ok(mut cb) = session_ref.chunk_callback.write() {
+        *cb = Some(callback);
+    }
+
+    // Set up the Rust callback that will call the C callback
+    let c_callback = session_ref.chunk_callback.clone();
+    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+    let rust_callback = Arc::new(move |track: &str, chunk: &FrameChunk, data: &[u8]| {
+        if let Ok(guard) = c_callback.read() {
+            if let Some(cb) = *guard {
+                let c_track = CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                let c_chunk = CFrameChunk {
+                    track_id: chunk.track_id,
+                    group_sequence: chunk.group_sequence,
+                    frame_index: chunk.frame_index,
+                    frame_size: chunk.frame_size,
+                    offset: chunk.offset,
+                    is_last: chunk.is_last as u8,
+                    error: chunk.error as u8,
+                };
+                cb(
+                    session_handle as *mut std::ffi::c_void,
+                    c_track.as_ptr(),
+                    &c_chunk,
+                    data.as_ptr(),
+                    data.len(),
+                );
+            }
+        }
+    });
+
+    // Set the callback in the session
+    session_ref.runtime.block_on(async {
+        session_ref.session.set_chunk_callback(rust_callback).await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Deliver a subscribed track chunk by chunk to the chunk callback, or as whole frames again
+///
+/// A running subscription of the track is restarted to switch modes.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_chunked_delivery(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    enabled: bool,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    session_ref.runtime.block_on(
+        session_ref
+            .session
+            .set_chunked_delivery(track_name, enabled),
+    );
+    0
+}
+
+/// Read received frames straight into caller-provided buffers
+///
+/// `provide` is asked for a buffer for each frame; returning null declines, and the frame is
+/// delivered to the usual callbacks. A provided buffer is filled once, chunk by chunk, and
+/// always handed back through `complete` with the bytes written, which are fewer than the
+/// requested size if the frame was cut short or its read abandoned (unsubscribe, pause,
+/// restart, or its group dropped from the window). A buffer whose capacity is below the
+/// requested size comes back empty, and the frame is delivered to the usual callbacks.
+/// Null callbacks remove the provider.
+///
+/// # Safety
+/// The caller must ensure that `session` is a valid pointer returned from
+/// `moq_create_subscriber`, and that every buffer returned by `provide` stays valid and
+/// unused for its stated capacity until passed to `complete`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_buffer_provider(
+    session: *mut CMoqSession,
+    provide: Option<CProvideBufferCallback>,
+    complete: Option<CBufferCompleteCallback>,
+) -> c_int {
+    if session.is_null() {
+        return MoqResult::InvalidArgument as c_int;
+    }
+
+    let session_ref = unsafe { &*session };
+
+    let callbacks = provide.zip(complete);
+    if let Ok(mut cb) = session_ref.buffer_provider.write() {
+        *cb = callbacks;
+    }
+
+    let provider = callbacks.map(|(_, complete)| {
+        let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
+        let c_provide = session_ref.buffer_provider.clone();
+        BufferProvider {
+            provide: Arc::new(move |track: &str, size: u64| {
+                let (provide, _) = (*c_provide.read().ok()?)?;
+                let c_track = CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                let mut capacity = 0usize;
+                let data = provide(
+                    session_handle as *mut std::ffi::c_void,
+                    c_track.as_ptr(),
+                    size,
+                    &mut capacity,
+                );
+                if data.is_null() {
+                    return None;
+                }
+                let buffer: ProvidedBuffer = Box::new(ForeignBuffer { data, capacity });
+                Some(buffer)
+            }),
+            complete: Arc::new(
+                move |track: &str, info: &FrameInfo, mut buffer: ProvidedBuffer, len: usize| {
+                    // Every buffer goes back to the callback paired with the one providing it
+                    let c_track = CString::new(track).unwrap_or_else(|_| CString::new("").unwrap());
+                    let c_info = CFrameInfo::from(info);
+                    complete(
+                        session_handle as *mut std::ffi::c_void,
+                        c_track.as_ptr(),
+                        &c_info,
+                        AsMut::<[u8]>::as_mut(&mut *buffer).as_mut_ptr(),
+                        len,
+                    );
+                },
+            ),
+        }
+    });
+
+    session_ref.runtime.block_on(async {
+        session_ref.session.set_buffer_provider(provider).await;
+    });
+
+    MoqResult::Success as c_int
+}
+
+/// Current time on the monotonic clock used for frame arrival times, in microseconds
+#[no_mangle]
+pub extern "C" fn moq_monotonic_time_us() -> u64 {
+    monotonic_micros(std::time::Instant::now())
+}
+
+/// Get the group sequence counters of a subscribed track
+///
+/// Returns -1 if the track has not received any frames yet.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `stats` points to writable memory for a `CSequenceStats`
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_get_sequence_stats(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    stats: *mut CSequenceStats,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || stats.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.sequence_stats(track_name))
+    {
+        Some(sequence) if sequence.groups > 0 => {
+            unsafe {
+                *stats = CSequenceStats {
+                    groups: sequence.groups,
+                    missing_groups: sequence.missing_groups,
+                    out_of_order_groups: sequence.out_of_order_groups,
+                    duplicate_groups: sequence.duplicate_groups,
+                }
+            };
+            0
+        }
+        _ => -1,
+    }
 }
 
-/// Set broadcast cancelled callback
+/// Bound how far a subscribed track may fall behind the live edge
+///
+/// Negative limits are unbounded; with both negative the policy is removed.
 ///
 /// # Safety
-/// The caller must ensure that `session` is a valid pointer returned from
-/// `moq_create_publisher` or `moq_create_subscriber`.
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
 #[no_mangle]
-pub unsafe extern "C" fn moq_session_set_broadcast_cancelled_callback(
+pub unsafe extern "C" fn moq_session_set_latency_policy(
     session: *mut CMoqSession,
-    callback: CBroadcastCancelledCallback,
+    track_name: *const c_char,
+    max_latency_ms: i64,
+    max_pending_groups: i64,
 ) -> c_int {
-    if session.is_null() {
-        return MoqResult::InvalidArgument as c_int;
+    if session.is_null() || track_name.is_null() {
+        return -1;
     }
 
     let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
 
-    // Store the C callback
-    if let Ok(mut cb) = session_ref.broadcast_cancelled_callback.write() {
-        *cb = Some(callback);
+    let policy = LatencyPolicy {
+        max_latency: u64::try_from(max_latency_ms)
+            .ok()
+            .map(std::time::Duration::from_millis),
+        max_pending_groups: usize::try_from(max_pending_groups).ok(),
+    };
+    let policy = (policy != LatencyPolicy::default()).then_some(policy);
+
+    session_ref
+        .runtime
+        .block_on(session_ref.session.set_latency_policy(track_name, policy));
+    0
+}
+
+/// Buffer a subscribed track's frames and release them at their playout time
+///
+/// A null `config` removes the jitter buffer.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `config` is null or points to a valid `CJitterConfig`
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_jitter_buffer(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    config: *const CJitterConfig,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
     }
 
-    // Set up the Rust callback that will call the C callback
-    let c_callback = session_ref.broadcast_cancelled_callback.clone();
-    let rust_callback = Box::new(move |path: &str| {
-        if let Ok(guard) = c_callback.read() {
-            if let Some(cb) = *guard {
-                let c_path = CString::new(path).unwrap_or_else(|_| CString::new("").unwrap());
-                cb(c_path.as_ptr());
-            }
-        }
-    });
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
 
-    // Set the callback in the session
-    session_ref.runtime.block_on(async {
-        session_ref
-            .session
-            .set_broadcast_cancelled_callback(rust_callback)
-            .await;
+    let config = unsafe { config.as_ref() }.map(|config| JitterConfig {
+        target_delay: std::time::Duration::from_millis(config.target_delay_ms.into()),
+        max_delay: std::time::Duration::from_millis(config.max_delay_ms.into()),
+        adaptive: config.adaptive != 0,
+        drop_late: config.drop_late != 0,
+        timestamp_format: match config.timestamp_format {
+            1 => TimestampFormat::U64MicrosBigEndian,
+            _ => TimestampFormat::VarintMicros,
+        },
     });
 
-    MoqResult::Success as c_int
+    session_ref
+        .runtime
+        .block_on(session_ref.session.set_jitter_buffer(track_name, config));
+    0
 }
 
-/// Set connection closed callback
+/// Get the jitter buffer statistics of a subscribed track
+///
+/// Returns -1 if the track has no jitter buffer or has not received frames yet.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `stats` points to writable memory for a `CJitterStats`
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_get_jitter_stats(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    stats: *mut CJitterStats,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || stats.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.jitter_stats(track_name))
+    {
+        Some(jitter) => {
+            unsafe {
+                *stats = CJitterStats {
+                    occupancy: jitter.occupancy,
+                    delay_us: jitter.delay.as_micros().try_into().unwrap_or(u64::MAX),
+                    jitter_us: jitter.jitter.as_micros().try_into().unwrap_or(u64::MAX),
+                    late_frames: jitter.late_frames,
+                    underruns: jitter.underruns,
+                    released: jitter.released,
+                }
+            };
+            0
+        }
+        None => -1,
+    }
+}
+
+/// Choose how a subscribed track's frames reach the data callback
+///
+/// `mode` is 0 to call the callback on the track's reader task, 1 to queue frames for the
+/// delivery threads; `overflow` is 0 to block, 1 to drop the oldest and 2 to drop the
+/// newest frame when the queue holds `capacity` frames.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_set_delivery_mode(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    mode: c_int,
+    capacity: usize,
+    overflow: c_int,
+) -> c_int {
+    if session.is_null() || track_name.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    let mode = match mode {
+        0 => DeliveryMode::Inline,
+        1 => DeliveryMode::Queued {
+            capacity,
+            overflow: match overflow {
+                0 => OverflowPolicy::Block,
+                1 => OverflowPolicy::DropOldest,
+                2 => OverflowPolicy::DropNewest,
+                _ => return -1,
+            },
+        },
+        _ => return -1,
+    };
+
+    match session_ref.session.set_delivery_mode(track_name, mode) {
+        Ok(_) => 0,
+        Err(_) => -1,
+    }
+}
+
+/// Get the delivery statistics of a subscribed track
+///
+/// Returns -1 if the session has no delivery threads or the track has not been subscribed.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `stats` points to writable memory for a `CDeliveryStats`
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_get_delivery_stats(
+    session: *mut CMoqSession,
+    track_name: *const c_char,
+    stats: *mut CDeliveryStats,
+) -> c_int {
+    if session.is_null() || track_name.is_null() || stats.is_null() {
+        return -1;
+    }
+
+    let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
+
+    match session_ref.session.delivery_stats(track_name) {
+        Some(delivery) => {
+            unsafe {
+                *stats = CDeliveryStats {
+                    delivered: delivery.delivered,
+                    dropped: delivery.dropped,
+                    queue_depth_p50: delivery.queue_depth.percentile(50.0),
+                    queue_depth_p99: delivery.queue_depth.percentile(99.0),
+                    callback_p50_us: delivery.callback_us.percentile(50.0),
+                    callback_p99_us: delivery.callback_us.percentile(99.0),
+                }
+            };
+            0
+        }
+        None => -1,
+    }
+}
+
+/// Get the latest catalog received by a subscriber
+///
+/// Returns null if no catalog has been received yet. The returned handle must be
+/// released with `moq_catalog_free`.
 ///
 /// # Safety
 /// The caller must ensure that `session` is a valid pointer returned from
 /// `moq_create_publisher` or `moq_create_subscriber`.
 #[no_mangle]
-pub unsafe extern "C" fn moq_session_set_connection_closed_callback(
+pub unsafe extern "C" fn moq_session_get_catalog(session: *mut CMoqSession) -> *mut CCatalog {
+    if session.is_null() {
+        return ptr::null_mut();
+    }
+
+    let session_ref = unsafe { &*session };
+
+    match session_ref
+        .runtime
+        .block_on(session_ref.session.catalog_snapshot())
+    {
+        Some(snapshot) => Box::into_raw(Box::new(CCatalog { snapshot })),
+        None => ptr::null_mut(),
+    }
+}
+
+/// Get the time a track took from subscribe request to its first group
+///
+/// Returns -1 if the track has not received any data yet.
+///
+/// # Safety
+/// The caller must ensure that:
+/// - `session` is a valid pointer returned from `moq_create_subscriber`
+/// - `track_name` is a valid null-terminated C string
+/// - `elapsed_us` points to writable memory for a `u64`
+#[no_mangle]
+pub unsafe extern "C" fn moq_session_get_subscribe_time(
     session: *mut CMoqSession,
-    callback: CConnectionClosedCallback,
+    track_name: *const c_char,
+    elapsed_us: *mut u64,
 ) -> c_int {
-    if session.is_null() {
-        return MoqResult::InvalidArgument as c_int;
+    if session.is_null() || track_name.is_null() || elapsed_us.is_null() {
+        return -1;
     }
 
     let session_ref = unsafe { &*session };
+    let track_name = match unsafe { CStr::from_ptr(track_name).to_str() } {
+        Ok(s) => s,
+        Err(_) => return -1,
+    };
 
-    // Store the C callback
-    if let Ok(mut cb) = session_ref.connection_closed_callback.write() {
-        *cb = Some(callback);
+    let times = session_ref
+        .runtime
+        .block_on(session_ref.session.track_subscribe_times());
+    match times.get(track_name) {
+        Some(elapsed) => {
+            unsafe { *elapsed_us = elapsed.as_micros().try_into().unwrap_or(u64::MAX) };
+            0
+        }
+        None => -1,
     }
+}
 
-    // Set up the Rust callback that will call the C callback
-    let c_callback = session_ref.connection_closed_callback.clone();
-    let session_handle = session as *mut std::ffi::c_void as usize; // Convert to usize for thread safety
-    let rust_callback = Box::new(move |reason: &str| {
-        if let Ok(guard) = c_callback.read() {
-            if let Some(cb) = *guard {
-                let c_reason = CString::new(reason).unwrap_or_else(|_| CString::new("").unwrap());
-                cb(session_handle as *mut std::ffi::c_void, c_reason.as_ptr());
-            }
+/// Get the version of a catalog snapshot
+///
+/// # Safety
+/// The caller must ensure that `catalog` is a valid pointer returned from
+/// `moq_session_get_catalog` or passed to a catalog callback.
+#[no_mangle]
+pub unsafe extern "C" fn moq_catalog_version(catalog: *const CCatalog) -> u64 {
+    if catalog.is_null() {
+        return 0;
+    }
+    unsafe { &*catalog }.snapshot.version()
+}
+
+/// Get the number of tracks in a catalog snapshot
+///
+/// # Safety
+/// The caller must ensure that `catalog` is a valid pointer returned from
+/// `moq_session_get_catalog` or passed to a catalog callback.
+#[no_mangle]
+pub unsafe extern "C" fn moq_catalog_track_count(catalog: *const CCatalog) -> usize {
+    if catalog.is_null() {
+        return 0;
+    }
+    unsafe { &*catalog }.snapshot.tracks().len()
+}
+
+fn fill_catalog_track(track: &TrackDefinition, out: &mut CCatalogTrack) {
+    out.name = track.name.as_ptr() as *const c_char;
+    out.name_len = track.name.len();
+    out.priority = track.priority;
+    out.track_type = match track.track_type {
+        TrackType::Video => CTrackType::Video as u8,
+        TrackType::Audio => CTrackType::Audio as u8,
+        TrackType::Data => CTrackType::Data as u8,
+    };
+}
+
+/// Get the track at `index` of a catalog snapshot, whose tracks are sorted by name
+///
+/// # Safety
+/// The caller must ensure that `catalog` is a valid catalog handle and `out` points to
+/// writable memory for one `CCatalogTrack`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_catalog_track_at(
+    catalog: *const CCatalog,
+    index: usize,
+    out: *mut CCatalogTrack,
+) -> c_int {
+    if catalog.is_null() || out.is_null() {
+        return -1;
+    }
+
+    match unsafe { &*catalog }.snapshot.tracks().get(index) {
+        Some(track) => {
+            fill_catalog_track(track, unsafe { &mut *out });
+            0
         }
-    });
+        None => -1,
+    }
+}
 
-    // Set the callback in the session
-    session_ref.runtime.block_on(async {
-        session_ref
-            .session
-            .set_connection_closed_callback(rust_callback)
-            .await;
-    });
+/// Look up a track by name in a catalog snapshot
+///
+/// Returns 0 and fills `out` (which may be null) if the track exists, -1 otherwise.
+///
+/// # Safety
+/// The caller must ensure that `catalog` is a valid catalog handle, `track_name` is a
+/// valid C string and `out` is null or points to writable memory for one `CCatalogTrack`.
+#[no_mangle]
+pub unsafe extern "C" fn moq_catalog_find_track(
+    catalog: *const CCatalog,
+    track_name: *const c_char,
+    out: *mut CCatalogTrack,
+) -> c_int {
+    if catalog.is_null() || track_name.is_null() {
+        return -1;
+    }
 
-    MoqResult::Success as c_int
+    let track_str = unsafe {
+        match CStr::from_ptr(track_name).to_str() {
+            Ok(s) => s,
+            Err(_) => return -1,
+        }
+    };
+
+    match unsafe { &*catalog }.snapshot.find_track(track_str) {
+        Some(track) => {
+            if !out.is_null() {
+                fill_catalog_track(track, unsafe { &mut *out });
+            }
+            0
+        }
+        None => -1,
+    }
+}
+
+/// Release a catalog snapshot handle
+///
+/// # Safety
+/// The caller must ensure that `catalog` was returned from `moq_session_get_catalog` or
+/// passed to a catalog callback, and has not been freed before.
+#[no_mangle]
+pub unsafe extern "C" fn moq_catalog_free(catalog: *mut CCatalog) {
+    if !catalog.is_null() {
+        unsafe {
+            drop(Box::from_raw(catalog));
+        }
+    }
 }
 
 /// # Safety
@@ -791,9 +2626,119 @@ pub unsafe extern "C" fn moq_session_free(session: *mut CMoqSession) {
         if let Ok(mut cb) = session_ref.connection_closed_callback.write() {
             *cb = None;
         }
+        if let Ok(mut cb) = session_ref.catalog_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.groups_skipped_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.frame_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.data_view_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.frame_batch_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.chunk_callback.write() {
+            *cb = None;
+        }
+        if let Ok(mut cb) = session_ref.buffer_provider.write() {
+            *cb = None;
+        }
 
         unsafe {
             drop(Box::from_raw(session));
         }
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::SessionConfig;
+    use moq_lite::{Broadcast, BroadcastConsumer, Track};
+
+    /// Publisher handle as C callers get it, writing into a local broadcast
+    fn publisher(tracks: &[TrackDefinition]) -> (*mut CMoqSession, BroadcastConsumer) {
+        let runtime = Arc::new(Runtime::new().unwrap());
+        let broadcast = Broadcast::produce();
+        let session = runtime.block_on(async {
+            let url = url::Url::parse("https://example.com/test").unwrap();
+            let session = MoqSession::publisher(
+                SessionConfig::new("test", url),
+                "test".to_string(),
+                CatalogType::None,
+                tracks.to_vec(),
+            )
+            .await
+            .unwrap();
+            session.attach_producer(broadcast.producer).await.unwrap();
+            session
+        });
+        let session = CMoqSession::new(Arc::new(session), runtime);
+        (Box::into_raw(Box::new(session)), broadcast.consumer)
+    }
+
+    #[test]
+    fn test_write_frame_parts() {
+        let (session, broadcast) = publisher(&[TrackDefinition::video("video", 1)]);
+        let track_name = CString::new("video").unwrap();
+        let part = |data: &[u8]| CFramePart {
+            data: data.as_ptr(),
+            size: data.len(),
+        };
+        let empty = CFramePart {
+            data: ptr::null(),
+            size: 0,
+        };
+
+        // Empty parts are skipped; the rest are gathered into one frame
+        let parts = [part(b"head"), empty, part(b"er:"), part(b"payload")];
+        let result = unsafe {
+            moq_write_frame_parts(
+                session,
+                track_name.as_ptr(),
+                parts.as_ptr(),
+                parts.len(),
+                true,
+            )
+        };
+        assert_eq!(result, 0);
+
+        // A part without data is rejected before anything is written
+        let missing = [
+            part(b"x"),
+            CFramePart {
+                data: ptr::null(),
+                size: 1,
+            },
+        ];
+        let result = unsafe {
+            moq_write_frame_parts(session, track_name.as_ptr(), missing.as_ptr(), 2, false)
+        };
+        assert_eq!(result, -1);
+
+        let runtime = unsafe { &*session }.runtime.clone();
+        let frames = runtime.block_on(async {
+            unsafe { &*session }
+                .session
+                .close_group("video")
+                .await
+                .unwrap();
+            let mut track = broadcast.subscribe_track(&Track {
+                name: "video".to_string(),
+                priority: 0,
+            });
+            let mut group = track.next_group().await.unwrap().unwrap();
+            let mut frames = Vec::new();
+            while let Some(frame) = group.read_frame().await.unwrap() {
+                frames.push(frame);
+            }
+            frames
+        });
+        assert_eq!(frames, [Bytes::from("header:payload")]);
+        unsafe { moq_session_free(session) };
+    }
+}
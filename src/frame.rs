@@ -0,0 +1,369 @@
+use bytes::Bytes;
+use moq_lite::FrameProducer;
+use std::sync::{Arc, OnceLock};
+use std::time::Instant;
+use tokio::sync::RwLock;
+
+use crate::config::WrapperError;
+use crate::subscription_manager::TrackDataCallback;
+
+/// Callback receiving each frame with its position in the track
+pub type FrameCallback = Arc<dyn Fn(&str, &FrameInfo, &[u8]) + Send + Sync>;
+
+/// Callback of a single subscribed track; the frame's `track_id` identifies the track
+pub type TrackFrameCallback = Arc<dyn Fn(&FrameInfo, &[u8]) + Send + Sync>;
+
+/// A track's own callback, shared between the session and the track's readers
+pub type TrackCallbackSlot = Arc<RwLock<Option<TrackFrameCallback>>>;
+
+/// Callback receiving a chunked track's frames piece by piece as they arrive
+pub type ChunkCallback = Arc<dyn Fn(&str, &FrameChunk, &[u8]) + Send + Sync>;
+
+/// Where a received chunk sits; `(group_sequence, frame_index)` identifies its frame
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct FrameChunk {
+    /// Session-wide integer id of the track
+    pub track_id: u32,
+    pub group_sequence: u64,
+    pub frame_index: u64,
+    /// Size of the whole frame, as announced by the publisher
+    pub frame_size: u64,
+    /// Offset of the chunk within the frame
+    pub offset: u64,
+    /// The chunk completes the frame
+    pub is_last: bool,
+    /// The frame ended or failed short of `frame_size`; set on a final, empty chunk
+    pub error: bool,
+}
+
+/// Where a received frame sits in its track, and when it arrived
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct FrameInfo {
+    /// Session-wide integer id of the track
+    pub track_id: u32,
+    /// Sequence number of the frame's group
+    pub group_sequence: u64,
+    /// Index of the frame within its group; 0 starts a group (a keyframe for video)
+    pub frame_index: u64,
+    /// Last frame of the group, when the group's end was known on arrival
+    pub end_of_group: bool,
+    /// When the frame was fully read
+    pub arrival: Instant,
+}
+
+impl FrameInfo {
+    /// Arrival time in microseconds on the library's monotonic clock (see `monotonic_micros`)
+    pub fn arrival_micros(&self) -> u64 {
+        monotonic_micros(self.arrival)
+    }
+}
+
+/// Microseconds from a process-wide origin to `instant`
+pub fn monotonic_micros(instant: Instant) -> u64 {
+    static ORIGIN: OnceLock<Instant> = OnceLock::new();
+    let origin = *ORIGIN.get_or_init(Instant::now);
+    instant.saturating_duration_since(origin).as_micros() as u64
+}
+
+/// A frame and its metadata, on its way to the application
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct ReceivedFrame {
+    pub info: FrameInfo,
+    pub data: Bytes,
+}
+
+impl AsRef<[u8]> for ReceivedFrame {
+    fn as_ref(&self) -> &[u8] {
+        &self.data
+    }
+}
+
+/// Chunk callback of one track in chunked delivery mode
+#[derive(Clone)]
+pub struct ChunkReceiver {
+    pub track_name: Arc<str>,
+    pub callback: Arc<RwLock<Option<ChunkCallback>>>,
+}
+
+impl ChunkReceiver {
+    pub async fn deliver(&self, chunk: &FrameChunk, data: &[u8]) {
+        if let Some(callback) = self.callback.read().await.as_ref() {
+            callback(&self.track_name, chunk, data);
+        }
+    }
+}
+
+/// Memory a received frame is read into, handed out by a `BufferProvider`
+pub type ProvidedBuffer = Box<dyn AsMut<[u8]> + Send>;
+/// Returns a buffer for a frame of the given track and size, or None to deliver it as usual
+pub type ProvideBufferFn = Arc<dyn Fn(&str, u64) -> Option<ProvidedBuffer> + Send + Sync>;
+/// Receives a provided buffer back with the frame's metadata and the bytes written to it
+pub type BufferCompleteFn = Arc<dyn Fn(&str, &FrameInfo, ProvidedBuffer, usize) + Send + Sync>;
+
+/// Reads received frames straight into application memory
+///
+/// Every buffer handed out comes back through `complete`, also when the read is abandoned
+/// because the track is unsubscribed, paused or restarted, or its group falls out of the
+/// window. A frame cut short comes back with fewer bytes than the size it was provided for,
+/// and a buffer smaller than that size comes back empty while the frame is delivered as usual.
+#[derive(Clone)]
+pub struct BufferProvider {
+    pub provide: ProvideBufferFn,
+    pub complete: BufferCompleteFn,
+}
+
+/// Buffer provider as seen by the readers of one track
+#[derive(Clone)]
+pub struct BufferTarget {
+    pub track_name: Arc<str>,
+    pub provider: Arc<RwLock<Option<BufferProvider>>>,
+}
+
+impl BufferTarget {
+    /// Buffer for a frame of `size` bytes, lent until the returned loan is dropped
+    ///
+    /// `info` is what the buffer is completed with if the read never gets to `finish`.
+    pub async fn provide(&self, size: u64, info: FrameInfo) -> Option<BufferLoan> {
+        let provider = self.provider.read().await.clone()?;
+        let mut buffer = (provider.provide)(&self.track_name, size)?;
+        Some(BufferLoan {
+            capacity: AsMut::<[u8]>::as_mut(&mut *buffer).len(),
+            buffer: Some(buffer),
+            complete: provider.complete,
+            track_name: self.track_name.clone(),
+            info,
+            len: 0,
+        })
+    }
+}
+
+/// A provided buffer on loan to one frame read; dropping it hands the buffer back through
+/// `complete` with the bytes written so far
+pub struct BufferLoan {
+    buffer: Option<ProvidedBuffer>,
+    capacity: usize,
+    complete: BufferCompleteFn,
+    track_name: Arc<str>,
+    info: FrameInfo,
+    pub len: usize,
+}
+
+impl BufferLoan {
+    /// The whole buffer, of the capacity the provider gave it
+    pub fn buffer(&mut self) -> &mut [u8] {
+        match self.buffer.as_mut() {
+            Some(buffer) => AsMut::<[u8]>::as_mut(&mut **buffer),
+            None => &mut [],
+        }
+    }
+
+    /// Bytes the buffer holds
+    pub fn capacity(&self) -> u64 {
+        self.capacity as u64
+    }
+
+    /// Hand the buffer back with the frame's final metadata
+    pub fn finish(mut self, info: FrameInfo) {
+        self.info = info;
+    }
+}
+
+impl Drop for BufferLoan {
+    fn drop(&mut self) {
+        if let Some(buffer) = self.buffer.take() {
+            (self.complete)(&self.track_name, &self.info, buffer, self.len);
+        }
+    }
+}
+
+/// A frame to publish, and whether it starts a new group
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct FrameSpec {
+    pub data: Bytes,
+    pub new_group: bool,
+}
+
+/// Streams one frame of a size given up front, chunk by chunk
+///
+/// Dropping the writer before `finish` abandons the frame.
+pub struct FrameWriter {
+    producer: FrameProducer,
+    size: u64,
+    written: u64,
+}
+
+impl FrameWriter {
+    pub(crate) fn new(producer: FrameProducer, size: u64) -> Self {
+        Self {
+            producer,
+            size,
+            written: 0,
+        }
+    }
+
+    /// Send the next chunk of the frame
+    pub fn append(&mut self, chunk: Bytes) -> Result<(), WrapperError> {
+        let len = chunk.len() as u64;
+        if len > self.remaining() {
+            return Err(WrapperError::Session(format!(
+                "Chunk of {} bytes overruns frame ({} of {} bytes written)",
+                len, self.written, self.size
+            )));
+        }
+        self.written += len;
+        self.producer.write_chunk(chunk);
+        Ok(())
+    }
+
+    /// Bytes still to be appended
+    pub fn remaining(&self) -> u64 {
+        self.size - self.written
+    }
+
+    /// Complete the frame; fails, abandoning it, if fewer bytes than announced were written
+    pub fn finish(self) -> Result<(), WrapperError> {
+        if self.written != self.size {
+            return Err(WrapperError::Session(format!(
+                "Frame finished after {} of {} bytes",
+                self.written, self.size
+            )));
+        }
+        self.producer.close();
+        Ok(())
+    }
+}
+
+/// Group sequence counters for one track
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct SequenceStats {
+    /// Groups that delivered at least one frame
+    pub groups: u64,
+    /// Sequence numbers skipped over and not (yet) received
+    pub missing_groups: u64,
+    /// Groups that started after a newer group had
+    pub out_of_order_groups: u64,
+    /// Groups whose sequence had already been seen
+    pub duplicate_groups: u64,
+    /// Newest group sequence seen
+    pub latest_group: Option<u64>,
+    // Bit n set: group `latest_group - n - 1` was seen
+    seen_before_latest: u64,
+}
+
+impl SequenceStats {
+    /// Account for a group whose first frame is being delivered
+    pub fn record_group(&mut self, sequence: u64) {
+        self.groups += 1;
+        let Some(latest) = self.latest_group else {
+            self.latest_group = Some(sequence);
+            return;
+        };
+
+        if sequence == latest {
+            self.duplicate_groups += 1;
+            return;
+        }
+        if sequence > latest {
+            let advance = sequence - latest;
+            self.missing_groups += advance - 1;
+            // The previous newest group is now `advance` behind
+            self.seen_before_latest = if advance <= 64 {
+                self.seen_before_latest
+                    .checked_shl(advance as u32)
+                    .unwrap_or(0)
+                    | 1 << (advance - 1)
+            } else {
+                0
+            };
+            self.latest_group = Some(sequence);
+            return;
+        }
+
+        let behind = latest - sequence - 1;
+        if behind < 64 {
+            let bit = 1 << behind;
+            if self.seen_before_latest & bit != 0 {
+                self.duplicate_groups += 1;
+                return;
+            }
+            self.seen_before_latest |= bit;
+        }
+        // A late group fills one of the gaps counted earlier (assumed to, beyond the last
+        // 64 sequences)
+        self.out_of_order_groups += 1;
+        self.missing_groups = self.missing_groups.saturating_sub(1);
+    }
+}
+
+/// Application callbacks a track's frames are handed to
+#[derive(Clone)]
+pub struct FrameReceivers {
+    pub data: Arc<RwLock<Option<TrackDataCallback>>>,
+    pub frame: Arc<RwLock<Option<FrameCallback>>>,
+    /// Callback set on this track alone (see `MoqSession::subscribe_track`)
+    pub track: TrackCallbackSlot,
+}
+
+impl FrameReceivers {
+    pub async fn deliver(&self, track_name: &str, frame: &ReceivedFrame) {
+        if let Some(callback) = self.data.read().await.as_ref() {
+            callback(track_name.to_string(), frame.data.to_vec());
+        }
+        if let Some(callback) = self.frame.read().await.as_ref() {
+            callback(track_name, &frame.info, &frame.data);
+        }
+        if let Some(callback) = self.track.read().await.as_ref() {
+            callback(&frame.info, &frame.data);
+        }
+    }
+
+    /// Like `deliver`, for threads outside the Tokio runtime
+    pub fn blocking_deliver(&self, track_name: &str, frame: &ReceivedFrame) {
+        if let Some(callback) = self.data.blocking_read().as_ref() {
+            callback(track_name.to_string(), frame.data.to_vec());
+        }
+        if let Some(callback) = self.frame.blocking_read().as_ref() {
+            callback(track_name, &frame.info, &frame.data);
+        }
+        if let Some(callback) = self.track.blocking_read().as_ref() {
+            callback(&frame.info, &frame.data);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_sequence_stats() {
+        let mut stats = SequenceStats::default();
+        for sequence in [10, 11, 14, 12, 15] {
+            stats.record_group(sequence);
+        }
+        assert_eq!(stats.groups, 5);
+        assert_eq!(stats.latest_group, Some(15));
+        // 12 and 13 were skipped over; 12 showed up late
+        assert_eq!(stats.missing_groups, 1);
+        assert_eq!(stats.out_of_order_groups, 1);
+    }
+
+    #[test]
+    fn test_sequence_stats_duplicates() {
+        let mut stats = SequenceStats::default();
+        // 15 repeats the newest group, the second 12 an older one; neither fills a gap
+        for sequence in [10, 11, 14, 12, 15, 15, 12] {
+            stats.record_group(sequence);
+        }
+        assert_eq!(stats.groups, 7);
+        assert_eq!(stats.latest_group, Some(15));
+        assert_eq!(stats.missing_groups, 1);
+        assert_eq!(stats.out_of_order_groups, 1);
+        assert_eq!(stats.duplicate_groups, 2);
+
+        // Once 13 arrives, every gap is filled
+        stats.record_group(13);
+        assert_eq!(stats.missing_groups, 0);
+        assert_eq!(stats.out_of_order_groups, 2);
+    }
+}
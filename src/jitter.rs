@@ -0,0 +1,393 @@
+use bytes::Bytes;
+use std::collections::VecDeque;
+use std::future::Future;
+use std::sync::{Arc, Mutex};
+use std::time::Duration;
+use tokio::sync::Notify;
+use tokio::task::JoinHandle;
+use tokio::time::{sleep_until, Instant};
+
+/// Timestamp jumps larger than this (publisher restart, clock change) re-anchor playout
+const RESYNC_THRESHOLD_US: i64 = 10_000_000;
+
+/// Where the publisher timestamp (in microseconds) is found in each frame
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum TimestampFormat {
+    /// Leading QUIC variable-length integer, as in the hang container
+    #[default]
+    VarintMicros,
+    /// Leading 8-byte big-endian integer
+    U64MicrosBigEndian,
+}
+
+impl TimestampFormat {
+    /// Read the timestamp of a frame, or None if the frame is too short
+    pub fn read(&self, frame: &[u8]) -> Option<u64> {
+        match self {
+            TimestampFormat::VarintMicros => {
+                let first = *frame.first()?;
+                let len = 1usize << (first >> 6);
+                let bytes = frame.get(..len)?;
+                let mut value = u64::from(first & 0x3f);
+                for byte in &bytes[1..] {
+                    value = (value << 8) | u64::from(*byte);
+                }
+                Some(value)
+            }
+            TimestampFormat::U64MicrosBigEndian => {
+                let bytes: [u8; 8] = frame.get(..8)?.try_into().ok()?;
+                Some(u64::from_be_bytes(bytes))
+            }
+        }
+    }
+}
+
+/// Per-track jitter buffer settings
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct JitterConfig {
+    /// Playout delay added on top of the fastest observed transit time
+    pub target_delay: Duration,
+    /// Upper bound for the adaptive delay
+    pub max_delay: Duration,
+    /// Grow the delay to three times the measured jitter when that exceeds the target
+    pub adaptive: bool,
+    /// Drop frames that arrive after their playout time instead of releasing them at once
+    pub drop_late: bool,
+    /// Where the publisher timestamp is found in each frame
+    pub timestamp_format: TimestampFormat,
+}
+
+impl Default for JitterConfig {
+    fn default() -> Self {
+        Self {
+            target_delay: Duration::from_millis(50),
+            max_delay: Duration::from_millis(500),
+            adaptive: true,
+            drop_late: false,
+            timestamp_format: TimestampFormat::default(),
+        }
+    }
+}
+
+/// Jitter buffer counters for one track
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct JitterStats {
+    /// Frames waiting for their playout time
+    pub occupancy: usize,
+    /// Current playout delay
+    pub delay: Duration,
+    /// Smoothed interarrival jitter
+    pub jitter: Duration,
+    /// Frames that arrived after their playout time
+    pub late_frames: u64,
+    /// Playout ticks (the expected time of the next frame) at which no frame was due
+    pub underruns: u64,
+    /// Frames released to the application
+    pub released: u64,
+}
+
+/// Orders frames by publisher timestamp and releases them on the local clock
+///
+/// Playout time is `timestamp + min transit + delay`, where the minimum transit is the
+/// fastest arrival seen relative to the first frame. Jitter is estimated as in RFC 3550.
+pub struct JitterBuffer<T = Bytes> {
+    config: JitterConfig,
+    frames: VecDeque<(Instant, T)>,
+    // First frame: local arrival and publisher timestamp
+    anchor: Option<(Instant, u64)>,
+    min_transit_us: i64,
+    last_transit_us: Option<i64>,
+    jitter_us: f64,
+    // Playout time of the last released frame, and the spacing of the last two
+    last_release: Option<Instant>,
+    interval: Option<Duration>,
+    // When the next frame should play; an underrun if none is due by then
+    next_tick: Option<Instant>,
+    stats: JitterStats,
+}
+
+impl<T: AsRef<[u8]>> JitterBuffer<T> {
+    pub fn new(config: JitterConfig) -> Self {
+        Self {
+            config,
+            frames: VecDeque::new(),
+            anchor: None,
+            min_transit_us: 0,
+            last_transit_us: None,
+            jitter_us: 0.0,
+            last_release: None,
+            interval: None,
+            next_tick: None,
+            stats: JitterStats {
+                delay: config.target_delay,
+                ..Default::default()
+            },
+        }
+    }
+
+    pub fn config(&self) -> &JitterConfig {
+        &self.config
+    }
+
+    /// Add a frame that arrived at `arrival`; frames without a timestamp are due at once
+    pub fn push(&mut self, frame: T, arrival: Instant) {
+        let Some(timestamp) = self.config.timestamp_format.read(frame.as_ref()) else {
+            self.insert(arrival, frame);
+            return;
+        };
+
+        let (anchor_at, anchor_ts) = *self.anchor.get_or_insert((arrival, timestamp));
+        let media_us = timestamp as i64 - anchor_ts as i64;
+        let mut transit_us =
+            arrival.saturating_duration_since(anchor_at).as_micros() as i64 - media_us;
+
+        if (transit_us - self.min_transit_us).abs() > RESYNC_THRESHOLD_US {
+            self.anchor = Some((arrival, timestamp));
+            self.min_transit_us = 0;
+            self.last_transit_us = None;
+            self.last_release = None;
+            self.next_tick = None;
+            transit_us = 0;
+        }
+
+        if let Some(last) = self.last_transit_us {
+            let deviation = (transit_us - last).abs() as f64;
+            self.jitter_us += (deviation - self.jitter_us) / 16.0;
+        }
+        self.last_transit_us = Some(transit_us);
+        self.min_transit_us = self.min_transit_us.min(transit_us);
+        self.update_delay();
+
+        let (anchor_at, anchor_ts) = self.anchor.unwrap_or((arrival, timestamp));
+        let offset_us = timestamp as i64 - anchor_ts as i64
+            + self.min_transit_us
+            + self.stats.delay.as_micros() as i64;
+        let playout = if offset_us >= 0 {
+            anchor_at + Duration::from_micros(offset_us as u64)
+        } else {
+            anchor_at
+                .checked_sub(Duration::from_micros(offset_us.unsigned_abs()))
+                .unwrap_or(anchor_at)
+        };
+
+        if playout <= arrival {
+            self.stats.late_frames += 1;
+            if self.config.drop_late {
+                return;
+            }
+        }
+        self.insert(playout, frame);
+    }
+
+    fn insert(&mut self, playout: Instant, frame: T) {
+        // Frames mostly arrive in order, so this is usually an append
+        let index = self.frames.partition_point(|(at, _)| *at <= playout);
+        self.frames.insert(index, (playout, frame));
+        self.stats.occupancy = self.frames.len();
+    }
+
+    fn update_delay(&mut self) {
+        let mut delay = self.config.target_delay;
+        if self.config.adaptive {
+            let cover = Duration::from_micros((self.jitter_us * 3.0) as u64);
+            delay = delay.max(cover).min(self.config.max_delay.max(delay));
+        }
+        self.stats.delay = delay;
+    }
+
+    /// Playout time of the next frame, or the next playout tick if that comes first
+    pub fn next_due(&self) -> Option<Instant> {
+        let front = self.frames.front().map(|(at, _)| *at);
+        match (front, self.next_tick) {
+            (Some(front), Some(tick)) => Some(front.min(tick)),
+            (front, tick) => front.or(tick),
+        }
+    }
+
+    /// Remove the frames whose playout time is at or before `now`
+    ///
+    /// Once frames are playing, each is expected one frame interval after the previous
+    /// one; reaching that tick with no frame due counts one underrun per gap.
+    pub fn pop_due(&mut self, now: Instant) -> Vec<T> {
+        let count = self.frames.partition_point(|(at, _)| *at <= now);
+        if count == 0 {
+            if self.next_tick.is_some_and(|tick| tick <= now) {
+                self.stats.underruns += 1;
+                self.next_tick = None;
+            }
+            return Vec::new();
+        }
+
+        let mut due = Vec::with_capacity(count);
+        for (at, frame) in self.frames.drain(..count) {
+            if let Some(previous) = self.last_release {
+                let spacing = at.saturating_duration_since(previous);
+                if !spacing.is_zero() {
+                    self.interval = Some(spacing);
+                }
+            }
+            self.last_release = Some(at);
+            due.push(frame);
+        }
+        self.next_tick = self
+            .last_release
+            .zip(self.interval)
+            .map(|(at, interval)| at + interval);
+        self.stats.released += due.len() as u64;
+        self.stats.occupancy = self.frames.len();
+        due
+    }
+
+    pub fn stats(&self) -> JitterStats {
+        JitterStats {
+            jitter: Duration::from_micros(self.jitter_us as u64),
+            ..self.stats
+        }
+    }
+}
+
+/// A jitter buffer with its own timer task releasing frames at their playout time
+pub struct Playout<T = Bytes> {
+    buffer: Arc<Mutex<JitterBuffer<T>>>,
+    wake: Arc<Notify>,
+    timer: JoinHandle<()>,
+}
+
+impl<T: AsRef<[u8]> + Send + 'static> Playout<T> {
+    /// Start the timer task; `release` receives every frame at its playout time
+    pub fn start<F, Fut>(config: JitterConfig, release: F) -> Self
+    where
+        F: Fn(T) -> Fut + Send + Sync + 'static,
+        Fut: Future<Output = ()> + Send,
+    {
+        let buffer = Arc::new(Mutex::new(JitterBuffer::new(config)));
+        let wake = Arc::new(Notify::new());
+
+        let timer_buffer = buffer.clone();
+        let timer_wake = wake.clone();
+        let timer = tokio::spawn(async move {
+            loop {
+                let due = timer_buffer
+                    .lock()
+                    .ok()
+                    .and_then(|buffer| buffer.next_due());
+                match due {
+                    Some(at) => {
+                        tokio::select! {
+                            _ = sleep_until(at) => {}
+                            _ = timer_wake.notified() => continue,
+                        }
+                    }
+                    None => {
+                        timer_wake.notified().await;
+                        continue;
+                    }
+                }
+
+                let frames = match timer_buffer.lock() {
+                    Ok(mut buffer) => buffer.pop_due(Instant::now()),
+                    Err(_) => return,
+                };
+                for frame in frames {
+                    release(frame).await;
+                }
+            }
+        });
+
+        Self {
+            buffer,
+            wake,
+            timer,
+        }
+    }
+
+    pub fn config(&self) -> JitterConfig {
+        self.buffer
+            .lock()
+            .map(|buffer| *buffer.config())
+            .unwrap_or_else(|poisoned| *poisoned.into_inner().config())
+    }
+
+    /// Queue a frame that just arrived
+    pub fn push(&self, frame: T) {
+        if let Ok(mut buffer) = self.buffer.lock() {
+            buffer.push(frame, Instant::now());
+        }
+        self.wake.notify_one();
+    }
+
+    /// Shared buffer, for reading its statistics
+    pub fn buffer(&self) -> Arc<Mutex<JitterBuffer<T>>> {
+        self.buffer.clone()
+    }
+}
+
+impl<T> Drop for Playout<T> {
+    fn drop(&mut self) {
+        self.timer.abort();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn frame(timestamp_us: u64) -> Bytes {
+        Bytes::copy_from_slice(&timestamp_us.to_be_bytes())
+    }
+
+    #[test]
+    fn test_jitter_buffer_playout() {
+        assert_eq!(TimestampFormat::VarintMicros.read(&[0x25]), Some(0x25));
+        assert_eq!(
+            TimestampFormat::VarintMicros.read(&[0x7b, 0xbd]),
+            Some(15293)
+        );
+        assert_eq!(TimestampFormat::VarintMicros.read(&[0x80, 0x00]), None);
+
+        let config = JitterConfig {
+            target_delay: Duration::from_millis(40),
+            adaptive: false,
+            timestamp_format: TimestampFormat::U64MicrosBigEndian,
+            ..Default::default()
+        };
+        let mut buffer = JitterBuffer::new(config);
+        let start = Instant::now();
+
+        // 20 ms frames; the second one is delayed by 30 ms and arrives after the third
+        buffer.push(frame(0), start);
+        buffer.push(frame(40_000), start + Duration::from_millis(40));
+        buffer.push(frame(20_000), start + Duration::from_millis(50));
+        assert_eq!(buffer.stats().occupancy, 3);
+
+        assert!(buffer.pop_due(start + Duration::from_millis(39)).is_empty());
+        assert_eq!(
+            buffer.pop_due(start + Duration::from_millis(60)),
+            vec![frame(0), frame(20_000)]
+        );
+        assert_eq!(buffer.next_due(), Some(start + Duration::from_millis(80)));
+        assert_eq!(
+            buffer.pop_due(start + Duration::from_millis(80)),
+            vec![frame(40_000)]
+        );
+        // Every frame so far was there by its playout tick
+        assert_eq!(buffer.stats().underruns, 0);
+        assert_eq!(buffer.stats().late_frames, 0);
+
+        // The tick for the next frame comes with nothing due: one underrun for the gap
+        assert_eq!(buffer.next_due(), Some(start + Duration::from_millis(100)));
+        assert!(buffer
+            .pop_due(start + Duration::from_millis(100))
+            .is_empty());
+        assert!(buffer
+            .pop_due(start + Duration::from_millis(120))
+            .is_empty());
+        assert_eq!(buffer.stats().underruns, 1);
+        assert_eq!(buffer.next_due(), None);
+
+        // The frame that was missing arrives 50 ms late, past its playout time
+        buffer.push(frame(60_000), start + Duration::from_millis(150));
+        assert_eq!(buffer.stats().late_frames, 1);
+        assert!(buffer.stats().jitter > Duration::ZERO);
+    }
+}
@@ -1,14 +1,31 @@
 pub mod catalog;
 pub mod config;
+pub mod delivery;
 pub mod ffi;
+pub mod frame;
+pub mod jitter;
 pub mod session;
 pub mod subscription_manager;
 pub mod track;
 
-pub use catalog::{Catalog, CatalogType, HangCatalog, SesameCatalog, TrackDefinition, TrackType};
-pub use config::{ConnectionConfig, SessionConfig, WrapperError};
+pub use catalog::{
+    Catalog, CatalogEncoding, CatalogError, CatalogPatch, CatalogSnapshot, CatalogType,
+    CatalogUpdate, HangCatalog, SesameCatalog, StartPosition, TrackDefinition, TrackFilter,
+    TrackType,
+};
+pub use config::{ConnectionConfig, GroupOrder, LatencyPolicy, SessionConfig, WrapperError};
+pub use delivery::{
+    DeliveryExecutor, DeliveryMode, DeliveryStats, FrameBatchCallback, FrameBatching, Histogram,
+    OverflowPolicy,
+};
+pub use frame::{
+    BufferProvider, ChunkCallback, FrameCallback, FrameChunk, FrameInfo, FrameReceivers, FrameSpec,
+    FrameWriter, ProvidedBuffer, ReceivedFrame, SequenceStats, TrackFrameCallback,
+};
+pub use jitter::{JitterConfig, JitterStats, TimestampFormat};
 pub use session::{
-    ConnectionInfo, DataCallback, MoqSession, SessionEvent, SessionLogCallback, SessionType,
+    CatalogCallback, ConnectionInfo, DataCallback, GroupsSkippedCallback, MoqSession, SessionEvent,
+    SessionLogCallback, SessionType,
 };
 pub use subscription_manager::BroadcastSubscriptionManager;
 pub use track::{StreamPublisher, TrackManager};
@@ -58,19 +75,7 @@ pub async fn create_publisher(
     tracks: Vec<TrackDefinition>,
     catalog_type: CatalogType,
 ) -> Result<MoqSession, WrapperError> {
-    let url = url::Url::parse(url)
-        .map_err(|e| WrapperError::InvalidConfig(format!("Invalid URL: {}", e)))?;
-
-    let config = SessionConfig::new(broadcast_name, url);
-    let session = MoqSession::publisher(
-        config,
-        broadcast_name.to_string(),
-        catalog_type,
-        tracks.clone(),
-    )
-    .await?;
-
-    session.start().await?;
+    let session = start_publisher(url, broadcast_name, tracks, catalog_type).await?;
 
     // Wait for initial connection (track producers will be created automatically)
     use tokio::time::{sleep, Duration};
@@ -81,6 +86,26 @@ pub async fn create_publisher(
     Ok(session)
 }
 
+/// Create a publisher session and start connecting, without waiting for the connection
+///
+/// See `MoqSession::connected`.
+pub async fn start_publisher(
+    url: &str,
+    broadcast_name: &str,
+    tracks: Vec<TrackDefinition>,
+    catalog_type: CatalogType,
+) -> Result<MoqSession, WrapperError> {
+    let url = url::Url::parse(url)
+        .map_err(|e| WrapperError::InvalidConfig(format!("Invalid URL: {}", e)))?;
+
+    let config = SessionConfig::new(broadcast_name, url);
+    let session =
+        MoqSession::publisher(config, broadcast_name.to_string(), catalog_type, tracks).await?;
+
+    session.start().await?;
+    Ok(session)
+}
+
 /// Write a frame to a track, optionally starting a new group
 /// If new_group is true, starts a new group before writing the frame
 pub async fn write_frame(
@@ -102,6 +127,38 @@ pub async fn write_frame(
         .map_err(|e| WrapperError::Session(format!("Failed to write frame: {}", e)))
 }
 
+/// Write a frame made of several parts without joining them, optionally starting a new group
+pub async fn write_frame_parts(
+    session: &MoqSession,
+    track_name: &str,
+    parts: Vec<Bytes>,
+    new_group: bool,
+) -> Result<(), WrapperError> {
+    if new_group {
+        session
+            .start_group(track_name)
+            .await
+            .map_err(|e| WrapperError::Session(format!("Failed to start group: {}", e)))?;
+    }
+
+    session
+        .write_frame_parts(track_name, parts)
+        .await
+        .map_err(|e| WrapperError::Session(format!("Failed to write frame: {}", e)))
+}
+
+/// Write a run of frames to a track in one call; each frame may start a new group
+pub async fn write_frames(
+    session: &MoqSession,
+    track_name: &str,
+    frames: Vec<FrameSpec>,
+) -> Result<(), WrapperError> {
+    session
+        .write_frames(track_name, frames)
+        .await
+        .map_err(|e| WrapperError::Session(format!("Failed to write frames: {}", e)))
+}
+
 /// Write a single frame in its own group (convenience method)
 /// Creates a new group, writes the frame, and closes the group
 pub async fn write_single_frame(
@@ -115,6 +172,36 @@ pub async fn write_single_frame(
         .map_err(|e| WrapperError::Session(format!("Failed to write single frame: {}", e)))
 }
 
+/// Add a track to a live publisher session and republish the catalog
+pub async fn add_track(
+    session: &MoqSession,
+    track_definition: TrackDefinition,
+) -> Result<(), WrapperError> {
+    session
+        .add_track(track_definition)
+        .await
+        .map_err(|e| WrapperError::Session(format!("Failed to add track: {}", e)))
+}
+
+/// Remove a track from a live publisher session and republish the catalog
+pub async fn remove_track(session: &MoqSession, track_name: &str) -> Result<(), WrapperError> {
+    session
+        .remove_track(track_name)
+        .await
+        .map_err(|e| WrapperError::Session(format!("Failed to remove track: {}", e)))
+}
+
+/// Subscribe to all catalog tracks matching any of the filters, following catalog changes
+pub async fn set_track_filters(
+    session: &MoqSession,
+    filters: Vec<TrackFilter>,
+) -> Result<(), WrapperError> {
+    session
+        .set_track_filters(filters)
+        .await
+        .map_err(|e| WrapperError::Session(format!("Failed to set track filters: {}", e)))
+}
+
 /// Create a quick subscriber session with specified tracks and catalog validation
 pub async fn create_subscriber(
     url: &str,
@@ -1,20 +1,29 @@
 use anyhow::{Context, Result};
 use bytes::Bytes;
 use rand::Rng;
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::sync::Arc;
-use tokio::sync::{broadcast, mpsc, watch, RwLock};
-use tokio::time::{timeout, Instant};
+use tokio::sync::{broadcast, mpsc, watch, Notify, RwLock};
+use tokio::time::{timeout, Duration, Instant};
 use tracing::{debug, error, info, warn, Level};
 
 use moq_lite::{
-    Broadcast, BroadcastConsumer, BroadcastProducer, GroupProducer, Origin, OriginConsumer,
+    Broadcast, BroadcastConsumer, BroadcastProducer, Frame, GroupProducer, Origin, OriginConsumer,
     OriginProducer, Session, Track, TrackConsumer, TrackProducer,
 };
 use moq_native::Client;
 
-use crate::catalog::{Catalog, CatalogType, TrackDefinition};
-use crate::config::{SessionConfig, WrapperError};
+use crate::catalog::{
+    Catalog, CatalogPatch, CatalogSnapshot, CatalogType, CatalogUpdate, TrackDefinition,
+    TrackFilter,
+};
+use crate::config::{LatencyPolicy, SessionConfig, WrapperError};
+use crate::delivery::{DeliveryExecutor, DeliveryMode, DeliveryStats, FrameBatching, TrackQueue};
+use crate::frame::{
+    BufferProvider, BufferTarget, ChunkCallback, ChunkReceiver, FrameCallback, FrameReceivers,
+    FrameSpec, FrameWriter, SequenceStats, TrackCallbackSlot, TrackFrameCallback,
+};
+use crate::jitter::{JitterConfig, JitterStats};
 
 /// Log callback function type for session-specific logging
 pub type SessionLogCallback = Box<dyn Fn(&str, Level, &str) + Send + Sync>;
@@ -90,13 +99,28 @@ pub enum SessionEvent {
     BroadcastAnnounced { path: String },
     BroadcastUnannounced { path: String },
     TrackRequested { name: String },
+    GroupsSkipped { track: String, count: u64 },
     Error { error: String },
 }
 
+/// Where the session's connection stands, as watched by `connected` and `closed`
+#[derive(Clone, Debug, PartialEq, Eq)]
+enum Link {
+    Pending,
+    Up,
+    Down(String),
+}
+
+/// Number of delta frames appended to a catalog.json group before a fresh snapshot
+/// group is started, bounding how much a newly joined subscriber has to replay
+const CATALOG_DELTAS_PER_GROUP: usize = 64;
+
 /// Callback function types for session events
 pub type BroadcastAnnouncedCallback = Box<dyn Fn(&str) + Send + Sync>;
 pub type BroadcastCancelledCallback = Box<dyn Fn(&str) + Send + Sync>;
 pub type ConnectionClosedCallback = Box<dyn Fn(&str) + Send + Sync>;
+pub type CatalogCallback = Box<dyn Fn(Arc<CatalogSnapshot>) + Send + Sync>;
+pub type GroupsSkippedCallback = Box<dyn Fn(&str, u64) + Send + Sync>;
 
 /// A high-level wrapper around moq-native that provides:
 /// - Automatic reconnection for both publish and subscribe sessions
@@ -122,7 +146,18 @@ pub struct MoqSession {
     catalog: Arc<RwLock<Option<Catalog>>>,
     catalog_type: Arc<RwLock<CatalogType>>,
     catalog_published: Arc<RwLock<bool>>,
+    catalog_group: Arc<RwLock<Option<CatalogGroup>>>,
+    // Serialized snapshot, reused for every publish until the catalog changes
+    catalog_bytes: Arc<RwLock<Option<Bytes>>>,
     requested_tracks: Arc<RwLock<Vec<TrackDefinition>>>,
+    track_filters: Arc<RwLock<Vec<TrackFilter>>>,
+
+    // Catalog changes seen by subscribers (tracks added/removed)
+    catalog_update_tx: broadcast::Sender<CatalogUpdate>,
+    // Latest catalog received by a subscriber
+    catalog_snapshot: Arc<RwLock<Option<Arc<CatalogSnapshot>>>>,
+    // Last catalog per broadcast name; kept across reconnects to resubscribe without waiting
+    catalog_cache: Arc<RwLock<HashMap<String, Arc<CatalogSnapshot>>>>,
 
     // Event notification
     event_tx: mpsc::UnboundedSender<SessionEvent>,
@@ -138,6 +173,8 @@ pub struct MoqSession {
     // Shutdown signal
     shutdown_tx: watch::Sender<bool>,
     shutdown_rx: watch::Receiver<bool>,
+    // Connection progress
+    link_tx: watch::Sender<Link>,
 
     // Session logging
     log_callback: Arc<RwLock<Option<SessionLogCallback>>>,
@@ -146,9 +183,34 @@ pub struct MoqSession {
     broadcast_announced_callback: Arc<RwLock<Option<BroadcastAnnouncedCallback>>>,
     broadcast_cancelled_callback: Arc<RwLock<Option<BroadcastCancelledCallback>>>,
     connection_closed_callback: Arc<RwLock<Option<ConnectionClosedCallback>>>,
+    catalog_callback: Arc<RwLock<Option<Arc<CatalogCallback>>>>,
+    groups_skipped_callback: Arc<RwLock<Option<GroupsSkippedCallback>>>,
+
+    // Live-edge catch-up per subscribed track
+    latency_policies: Arc<RwLock<HashMap<String, LatencyPolicy>>>,
+    // Tracks whose upstream subscription is dropped until resumed
+    paused_tracks: Arc<RwLock<HashSet<String>>>,
+    // Tracks delivered chunk by chunk instead of as whole frames
+    chunked_tracks: Arc<RwLock<HashSet<String>>>,
+    // Jitter buffer per subscribed track; track readers watch it instead of locking per frame
+    jitter_configs: Arc<watch::Sender<HashMap<String, JitterConfig>>>,
+    // Runs data callbacks off the runtime (subscribers with delivery_threads > 0)
+    delivery: Option<Arc<DeliveryExecutor>>,
 
     // Data callback for BroadcastSubscriptionManager
     data_callback: OptionalDataCallback,
+    // Frame callback with metadata, read by track readers on every frame
+    frame_callback: Arc<RwLock<Option<FrameCallback>>>,
+    // Chunk callback of tracks in chunked delivery mode
+    chunk_callback: Arc<RwLock<Option<ChunkCallback>>>,
+    // Application memory frames are read into, when it provides any
+    buffer_provider: Arc<RwLock<Option<BufferProvider>>>,
+    // Integer ids handed out to track names, stable for the session's lifetime
+    track_ids: Arc<RwLock<HashMap<String, u32>>>,
+    // Per-track frame callbacks by track id; a slot exists once a reader of the track does
+    track_callbacks: Arc<RwLock<HashMap<u32, TrackCallbackSlot>>>,
+    // Tracks subscribed with their own callback, by track id
+    subscribed_tracks: Arc<RwLock<HashMap<u32, String>>>,
     // Catalog management is now handled by BroadcastSubscriptionManager
 }
 
@@ -157,6 +219,10 @@ struct SessionState {
     connected: bool,
     connection_attempts: usize,
     last_connection_time: Option<Instant>,
+    reannouncements: usize,
+    last_recovery_time: Option<Duration>,
+    // Re-announcement whose resubscribed tracks haven't received a group yet
+    recovering_since: Option<Instant>,
     current_session: Option<SessionHandle>,
     broadcast: Option<BroadcastHandle>,
     // Store the broadcast consumer for subscribers (called once after connection)
@@ -171,6 +237,12 @@ struct TrackHandle {
     track_definition: Option<TrackDefinition>,
 }
 
+/// The open catalog.json group; catalog deltas are appended to it as frames
+struct CatalogGroup {
+    producer: GroupProducer,
+    deltas: usize,
+}
+
 #[derive(Clone)]
 struct BroadcastHandle {
     producer: Option<BroadcastProducer>,
@@ -250,16 +322,24 @@ impl MoqSession {
         let (event_tx, event_rx) = mpsc::unbounded_channel();
         let (shutdown_tx, shutdown_rx) = watch::channel(false);
         let (announcement_tx, _) = broadcast::channel(100); // Buffer up to 100 announcements
+        let (catalog_update_tx, _) = broadcast::channel(100);
 
         let state = Arc::new(RwLock::new(SessionState {
             connected: false,
             connection_attempts: 0,
             last_connection_time: None,
+            reannouncements: 0,
+            last_recovery_time: None,
+            recovering_since: None,
             current_session: None,
             broadcast: None,
             broadcast_consumer: None,
         }));
 
+        let delivery = (matches!(session_type, SessionType::Subscriber)
+            && config.delivery_threads > 0)
+            .then(|| Arc::new(DeliveryExecutor::new(config.delivery_threads)));
+
         let mut session = Self {
             config,
             session_type: session_type.clone(),
@@ -270,20 +350,40 @@ impl MoqSession {
             current_groups: Arc::new(RwLock::new(HashMap::new())),
             sequence_numbers: Arc::new(RwLock::new(HashMap::new())),
             catalog: Arc::new(RwLock::new(None)),
-            catalog_type: Arc::new(RwLock::new(CatalogType::None)),
+            catalog_type: Arc::new(RwLock::new(catalog_type.clone())),
             catalog_published: Arc::new(RwLock::new(false)),
+            catalog_group: Arc::new(RwLock::new(None)),
+            catalog_bytes: Arc::new(RwLock::new(None)),
             requested_tracks: Arc::new(RwLock::new(Vec::new())),
+            track_filters: Arc::new(RwLock::new(Vec::new())),
+            catalog_update_tx,
+            catalog_snapshot: Arc::new(RwLock::new(None)),
+            catalog_cache: Arc::new(RwLock::new(HashMap::new())),
             event_tx,
             event_rx: Arc::new(RwLock::new(Some(event_rx))),
             announcement_tx,
             broadcast_subscription_manager: Arc::new(RwLock::new(None)),
             shutdown_tx,
+            link_tx: watch::Sender::new(Link::Pending),
             shutdown_rx,
             log_callback: Arc::new(RwLock::new(None)),
             broadcast_announced_callback: Arc::new(RwLock::new(None)),
             broadcast_cancelled_callback: Arc::new(RwLock::new(None)),
             connection_closed_callback: Arc::new(RwLock::new(None)),
+            catalog_callback: Arc::new(RwLock::new(None)),
+            groups_skipped_callback: Arc::new(RwLock::new(None)),
+            latency_policies: Arc::new(RwLock::new(HashMap::new())),
+            paused_tracks: Arc::new(RwLock::new(HashSet::new())),
+            chunked_tracks: Arc::new(RwLock::new(HashSet::new())),
+            jitter_configs: Arc::new(watch::Sender::new(HashMap::new())),
+            delivery,
             data_callback: Arc::new(RwLock::new(None)),
+            frame_callback: Arc::new(RwLock::new(None)),
+            chunk_callback: Arc::new(RwLock::new(None)),
+            buffer_provider: Arc::new(RwLock::new(None)),
+            track_ids: Arc::new(RwLock::new(HashMap::new())),
+            track_callbacks: Arc::new(RwLock::new(HashMap::new())),
+            subscribed_tracks: Arc::new(RwLock::new(HashMap::new())),
         };
 
         // loop through tracks and add
@@ -313,6 +413,7 @@ impl MoqSession {
         let broadcast_name = self.broadcast_name.clone();
         let mut shutdown_rx = self.shutdown_rx.clone();
         let announcement_tx = self.announcement_tx.clone();
+        let link_tx = self.link_tx.clone();
         let session_clone = self.clone();
 
         // Get callback references for announcements
@@ -362,10 +463,12 @@ impl MoqSession {
                         } else {
                             debug!("Successfully created track producers");
                             let _ = event_tx.send(SessionEvent::Connected);
+                            link_tx.send_replace(Link::Up);
                         }
                     } else {
                         // Send Connected event after successful broadcast subscription
                         let _ = event_tx.send(SessionEvent::Connected);
+                        link_tx.send_replace(Link::Up);
 
                         // Setup announcement monitoring for both publishers and subscribers
                         Self::monitor_announcements(
@@ -414,6 +517,7 @@ impl MoqSession {
                     drop(callback_guard);
 
                     // Send disconnected event
+                    link_tx.send_replace(Link::Down(disconnect_reason.clone()));
                     let _ = event_tx.send(SessionEvent::Disconnected {
                         reason: disconnect_reason,
                     });
@@ -429,6 +533,7 @@ impl MoqSession {
 
                     // Clear session state
                     session_clone.current_groups.write().await.clear();
+                    *session_clone.catalog_group.write().await = None;
                     *session_clone.catalog_published.write().await = false;
 
                     debug!("Session closed and cleaned up");
@@ -451,6 +556,7 @@ impl MoqSession {
                     let _ = event_tx.send(SessionEvent::Error {
                         error: format!("Connection failed: {}", e),
                     });
+                    link_tx.send_replace(Link::Down(format!("Connection failed: {}", e)));
 
                     drop(state_guard);
                 }
@@ -550,6 +656,12 @@ impl MoqSession {
         session: MoqSession, // Add session reference to handle BroadcastSubscriptionManager lifecycle
     ) {
         tokio::spawn(async move {
+            let announced = Arc::new(Notify::new());
+            let handler = tokio::spawn(Self::handle_announcements(
+                session.clone(),
+                announced.clone(),
+            ));
+
             while let Some((path, broadcast)) = origin_consumer.announced().await {
                 match broadcast {
                     Some(_) => {
@@ -559,9 +671,9 @@ impl MoqSession {
                         // Also send to internal broadcast channel for BroadcastSubscriptionManager
                         let _ = announcement_tx.send(path.to_string());
 
-                        // Handle announcement for our namespace - create or recreate BroadcastSubscriptionManager
+                        // Handle announcement for our namespace - create or resume BroadcastSubscriptionManager
                         if path.as_ref() == session.broadcast_name {
-                            let _ = session.create_or_recreate_manager().await;
+                            announced.notify_one();
                         }
 
                         // Call the broadcast announced callback if set
@@ -586,9 +698,68 @@ impl MoqSession {
                     }
                 }
             }
+
+            handler.abort();
         });
     }
 
+    /// Act on announcements of our broadcast path
+    ///
+    /// The first announcement creates the subscription manager right away. Later ones
+    /// are debounced over `announce_debounce` and resume the existing manager.
+    async fn handle_announcements(session: MoqSession, announced: Arc<Notify>) {
+        loop {
+            announced.notified().await;
+            let announced_at = Instant::now();
+
+            if session
+                .broadcast_subscription_manager
+                .read()
+                .await
+                .is_some()
+            {
+                let window = session.config.announce_debounce;
+                while timeout(window, announced.notified()).await.is_ok() {}
+            }
+
+            let _ = session.create_or_resume_manager(announced_at).await;
+        }
+    }
+
+    /// Wait until the session is connected and ready to publish or receive
+    ///
+    /// Resolves with the outcome of the session's connection attempt. `start` connects once
+    /// and does not retry, so a failed attempt is final: this fails with the reason if the
+    /// connection cannot be established or closes first, or if the session is shut down
+    /// while still connecting.
+    pub async fn connected(&self) -> Result<()> {
+        let mut link = self.link_tx.subscribe();
+        let mut shutdown = self.shutdown_rx.clone();
+        tokio::select! {
+            biased;
+            link = link.wait_for(|link| *link != Link::Pending) => match link?.clone() {
+                Link::Down(reason) => Err(WrapperError::Session(reason).into()),
+                _ => Ok(()),
+            },
+            _ = shutdown.wait_for(|shutdown| *shutdown) => {
+                Err(WrapperError::Session("Shutdown requested".to_string()).into())
+            }
+        }
+    }
+
+    /// Wait until the session's connection closes, returning the reason
+    pub async fn closed(&self) -> String {
+        let mut link = self.link_tx.subscribe();
+        let link = link
+            .wait_for(|link| matches!(link, Link::Down(_)))
+            .await
+            .map(|link| link.clone());
+        match link {
+            Ok(Link::Down(reason)) => reason,
+            _ => "Session dropped".to_string(),
+        }
+    }
+
     /// Get the next session event
     pub async fn next_event(&self) -> Option<SessionEvent> {
         let mut guard = self.event_rx.write().await;
@@ -604,6 +775,83 @@ impl MoqSession {
         self.announcement_tx.subscribe()
     }
 
+    /// Subscribe to catalog changes (tracks added or removed) seen by this subscriber
+    ///
+    /// The receiver survives BroadcastSubscriptionManager recreation on re-announcement.
+    pub fn subscribe_catalog_updates(&self) -> broadcast::Receiver<CatalogUpdate> {
+        self.catalog_update_tx.subscribe()
+    }
+
+    /// Sender used by the BroadcastSubscriptionManager to report catalog changes
+    pub(crate) fn catalog_update_sender(&self) -> broadcast::Sender<CatalogUpdate> {
+        self.catalog_update_tx.clone()
+    }
+
+    /// Latest catalog received by this subscriber, if any
+    pub async fn catalog_snapshot(&self) -> Option<Arc<CatalogSnapshot>> {
+        self.catalog_snapshot.read().await.clone()
+    }
+
+    /// Time from subscribe request to first group for each subscribed track with data
+    pub async fn track_subscribe_times(&self) -> HashMap<String, Duration> {
+        match self.broadcast_subscription_manager.read().await.as_ref() {
+            Some(manager) => manager.get_subscribe_times().await,
+            None => HashMap::new(),
+        }
+    }
+
+    /// Session configuration
+    pub fn config(&self) -> &SessionConfig {
+        &self.config
+    }
+
+    /// Last catalog received for a broadcast, surviving reconnects and re-announcements
+    pub async fn cached_catalog(&self, broadcast_name: &str) -> Option<Arc<CatalogSnapshot>> {
+        self.catalog_cache.read().await.get(broadcast_name).cloned()
+    }
+
+    /// Store a new catalog snapshot and notify the catalog callback if its tracks changed
+    pub(crate) async fn set_catalog_snapshot(
+        &self,
+        broadcast_name: &str,
+        snapshot: Arc<CatalogSnapshot>,
+    ) {
+        self.catalog_cache
+            .write()
+            .await
+            .insert(broadcast_name.to_string(), snapshot.clone());
+
+        let changed = {
+            let mut current = self.catalog_snapshot.write().await;
+            let changed = current
+                .as_ref()
+                .is_none_or(|previous| previous.tracks() != snapshot.tracks());
+            *current = Some(snapshot.clone());
+            changed
+        };
+
+        if changed {
+            // Called without the lock held, so the callback may use the session
+            let callback = self.catalog_callback.read().await.clone();
+            if let Some(callback) = callback {
+                callback(snapshot);
+            }
+        }
+    }
+
+    /// Note a track's first group; completes the recovery from a re-announcement, if any
+    pub(crate) async fn record_first_group(&self) {
+        let mut state = self.state.write().await;
+        if let Some(since) = state.recovering_since.take() {
+            let recovery = since.elapsed();
+            state.last_recovery_time = Some(recovery);
+            debug!(
+                "Recovered broadcast '{}' {:?} after re-announcement",
+                self.broadcast_name, recovery
+            );
+        }
+    }
+
     /// Check if the session is currently connected
     pub async fn is_connected(&self) -> bool {
         self.state.read().await.connected
@@ -616,6 +864,8 @@ impl MoqSession {
             connected: state.connected,
             connection_attempts: state.connection_attempts,
             last_connection_time: state.last_connection_time,
+            reannouncements: state.reannouncements,
+            last_recovery_time: state.last_recovery_time,
         }
     }
 
@@ -651,6 +901,361 @@ impl MoqSession {
         *self.connection_closed_callback.write().await = Some(callback);
     }
 
+    /// Set callback for when the subscribed catalog changes
+    ///
+    /// Fires with the new snapshot whenever the set of tracks (or their type/priority)
+    /// changes; if a catalog was already received it fires once immediately.
+    ///
+    /// No lock is held while the callback runs, so it may use the session, including
+    /// replacing itself.
+    pub async fn set_catalog_callback(&self, callback: CatalogCallback) {
+        let callback: Arc<CatalogCallback> = Arc::new(callback);
+        self.install_catalog_callback(callback.clone()).await;
+        let mut delivered = None;
+        while let Some(snapshot) = self.catalog_to_replay(delivered.as_ref()).await {
+            callback(snapshot.clone());
+            delivered = Some(snapshot);
+        }
+    }
+
+    /// Install the catalog callback without replaying the current catalog to it
+    pub(crate) async fn install_catalog_callback(&self, callback: Arc<CatalogCallback>) {
+        *self.catalog_callback.write().await = Some(callback);
+    }
+
+    /// Catalog a newly installed callback still has to see, given the last one replayed
+    ///
+    /// Snapshots stored after the callback was installed reach it through
+    /// `set_catalog_snapshot`; replaying until this returns None catches up on any stored
+    /// before, including one that raced with the install.
+    pub(crate) async fn catalog_to_replay(
+        &self,
+        delivered: Option<&Arc<CatalogSnapshot>>,
+    ) -> Option<Arc<CatalogSnapshot>> {
+        let latest = self.catalog_snapshot.read().await.clone()?;
+        match delivered {
+            Some(delivered) if Arc::ptr_eq(delivered, &latest) => None,
+            _ => Some(latest),
+        }
+    }
+
+    /// Set callback for when groups of a track are skipped to catch up with the live edge
+    pub async fn set_groups_skipped_callback(&self, callback: GroupsSkippedCallback) {
+        *self.groups_skipped_callback.write().await = Some(callback);
+    }
+
+    /// Set callback receiving every subscribed frame with its group sequence, index within
+    /// the group, end-of-group flag, arrival time and track id
+    ///
+    /// Runs alongside the data callback, on the same thread and in the same order.
+    pub async fn set_frame_callback(&self, callback: FrameCallback) {
+        *self.frame_callback.write().await = Some(callback);
+    }
+
+    /// Callbacks a subscribed track's frames are delivered to
+    pub(crate) async fn frame_receivers(
+        &self,
+        track_id: u32,
+        data: OptionalDataCallback,
+    ) -> FrameReceivers {
+        FrameReceivers {
+            data,
+            frame: self.frame_callback.clone(),
+            track: self.track_callback_slot(track_id).await,
+        }
+    }
+
+    async fn track_callback_slot(&self, track_id: u32) -> TrackCallbackSlot {
+        self.track_callbacks
+            .write()
+            .await
+            .entry(track_id)
+            .or_default()
+            .clone()
+    }
+
+    /// Subscribe to a track and deliver its frames to a callback of its own
+    ///
+    /// Returns the track's integer id, which every frame handed to `callback` carries in
+    /// `FrameInfo::track_id`; the name is looked up once here, never per frame. The callback
+    /// runs alongside the data and frame callbacks. Tracks not requested at creation or
+    /// picked by a filter are subscribed until `unsubscribe_track`, across reconnects.
+    /// A track takes one such callback at a time.
+    pub async fn subscribe_track(
+        &self,
+        track_name: &str,
+        callback: TrackFrameCallback,
+    ) -> Result<u32> {
+        if !matches!(self.session_type, SessionType::Subscriber) {
+            return Err(WrapperError::Session("Not a subscriber session".to_string()).into());
+        }
+        let track_id = self.track_id(track_name).await;
+        {
+            let mut subscribed = self.subscribed_tracks.write().await;
+            if subscribed.contains_key(&track_id) {
+                return Err(WrapperError::Session(format!(
+                    "Track '{}' already has a subscription",
+                    track_name
+                ))
+                .into());
+            }
+            subscribed.insert(track_id, track_name.to_string());
+        }
+        *self.track_callback_slot(track_id).await.write().await = Some(callback);
+
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            manager.subscribe_track(track_name).await;
+        }
+        Ok(track_id)
+    }
+
+    /// End a subscription made with `subscribe_track`
+    ///
+    /// Once this returns the track's callback is not called again. The track itself stays
+    /// subscribed if it was requested at creation or matches a filter.
+    pub async fn unsubscribe_track(&self, track_id: u32) -> Result<()> {
+        let Some(track_name) = self.subscribed_tracks.write().await.remove(&track_id) else {
+            return Err(WrapperError::Session(format!(
+                "No subscription for track id {}",
+                track_id
+            ))
+            .into());
+        };
+        // Waits for a callback in progress
+        if let Some(slot) = self.track_callbacks.read().await.get(&track_id) {
+            *slot.write().await = None;
+        }
+
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            manager.unsubscribe_track(&track_name).await;
+        }
+        Ok(())
+    }
+
+    /// Names of the tracks subscribed with `subscribe_track`
+    pub async fn subscribed_tracks(&self) -> Vec<String> {
+        self.subscribed_tracks
+            .read()
+            .await
+            .values()
+            .cloned()
+            .collect()
+    }
+
+    /// Set callback receiving the frames of chunked tracks as their data arrives
+    ///
+    /// See `set_chunked_delivery`.
+    pub async fn set_chunk_callback(&self, callback: ChunkCallback) {
+        *self.chunk_callback.write().await = Some(callback);
+    }
+
+    /// Deliver a subscribed track chunk by chunk, before each frame has fully arrived
+    ///
+    /// Chunks go to the chunk callback straight from the task reading the track, so large
+    /// objects are never assembled in memory; the data and frame callbacks, jitter buffer and
+    /// delivery queue are bypassed. The track is read one group at a time whatever the
+    /// `group_window`, so chunks arrive in order. A frame cut short ends with an empty chunk
+    /// flagged `error`. A running subscription is restarted to switch modes.
+    pub async fn set_chunked_delivery(&self, track_name: &str, enabled: bool) {
+        let changed = {
+            let mut tracks = self.chunked_tracks.write().await;
+            if enabled {
+                tracks.insert(track_name.to_string())
+            } else {
+                tracks.remove(track_name)
+            }
+        };
+        if changed {
+            if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+                manager.restart_track(track_name).await;
+            }
+        }
+    }
+
+    /// Chunk callback of a track in chunked delivery mode
+    pub(crate) async fn chunk_receiver(&self, track_name: &str) -> Option<ChunkReceiver> {
+        if !self.chunked_tracks.read().await.contains(track_name) {
+            return None;
+        }
+        Some(ChunkReceiver {
+            track_name: track_name.into(),
+            callback: self.chunk_callback.clone(),
+        })
+    }
+
+    /// Read received frames straight into buffers supplied by the application
+    ///
+    /// Each frame is copied once, chunk by chunk, into the buffer the provider returns for
+    /// it, and then handed back through the provider's completion callback on the task
+    /// reading the track. Frames the provider declines or gives too small a buffer for, and
+    /// frames of chunked tracks, are delivered as usual. Pass `None` to stop.
+    pub async fn set_buffer_provider(&self, provider: Option<BufferProvider>) {
+        *self.buffer_provider.write().await = provider;
+    }
+
+    /// Buffer provider as seen by the readers of a track
+    pub(crate) fn buffer_target(&self, track_name: &str) -> BufferTarget {
+        BufferTarget {
+            track_name: track_name.into(),
+            provider: self.buffer_provider.clone(),
+        }
+    }
+
+    /// Integer id of a track, assigned on first use and never reused within the session
+    pub async fn track_id(&self, track_name: &str) -> u32 {
+        if let Some(id) = self.track_ids.read().await.get(track_name) {
+            return *id;
+        }
+        let mut track_ids = self.track_ids.write().await;
+        let next = track_ids.len() as u32;
+        *track_ids.entry(track_name.to_string()).or_insert(next)
+    }
+
+    /// Group sequence gaps and reordering seen on a subscribed track
+    pub async fn sequence_stats(&self, track_name: &str) -> Option<SequenceStats> {
+        match self.broadcast_subscription_manager.read().await.as_ref() {
+            Some(manager) => manager.get_sequence_stats(track_name).await,
+            None => None,
+        }
+    }
+
+    /// Stop receiving a subscribed track without forgetting it
+    ///
+    /// The upstream subscription is dropped, so the publisher stops sending the track, while
+    /// its settings and statistics are kept for a fast `resume_track`. Pauses persist across
+    /// reconnects and catalog updates.
+    pub async fn pause_track(&self, track_name: &str) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Subscriber) {
+            return Err(WrapperError::Session("Not a subscriber session".to_string()).into());
+        }
+        if !self
+            .paused_tracks
+            .write()
+            .await
+            .insert(track_name.to_string())
+        {
+            return Ok(());
+        }
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            manager.pause_track(track_name).await;
+        }
+        Ok(())
+    }
+
+    /// Subscribe again to a track stopped with `pause_track`
+    pub async fn resume_track(&self, track_name: &str) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Subscriber) {
+            return Err(WrapperError::Session("Not a subscriber session".to_string()).into());
+        }
+        if !self.paused_tracks.write().await.remove(track_name) {
+            return Ok(());
+        }
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            manager.resume_track(track_name).await;
+        }
+        Ok(())
+    }
+
+    pub async fn is_track_paused(&self, track_name: &str) -> bool {
+        self.paused_tracks.read().await.contains(track_name)
+    }
+
+    /// Bound how far a subscribed track may fall behind the live edge (None removes the bound)
+    pub async fn set_latency_policy(&self, track_name: &str, policy: Option<LatencyPolicy>) {
+        let mut policies = self.latency_policies.write().await;
+        match policy {
+            Some(policy) => policies.insert(track_name.to_string(), policy),
+            None => policies.remove(track_name),
+        };
+    }
+
+    /// Latency policy of a subscribed track, if any
+    pub async fn latency_policy(&self, track_name: &str) -> Option<LatencyPolicy> {
+        self.latency_policies.read().await.get(track_name).copied()
+    }
+
+    /// Buffer a subscribed track's frames and release them on a steady clock (None disables)
+    ///
+    /// Frames are timed by the publisher timestamp they carry (see `TimestampFormat`) and
+    /// released by a timer task after the configured playout delay.
+    pub async fn set_jitter_buffer(&self, track_name: &str, config: Option<JitterConfig>) {
+        self.jitter_configs.send_modify(|configs| {
+            match config {
+                Some(config) => configs.insert(track_name.to_string(), config),
+                None => configs.remove(track_name),
+            };
+        });
+    }
+
+    /// Jitter buffer settings of a subscribed track, if any
+    pub async fn jitter_config(&self, track_name: &str) -> Option<JitterConfig> {
+        self.jitter_configs.borrow().get(track_name).copied()
+    }
+
+    /// Jitter buffer settings of every track, marked changed on each update
+    pub(crate) fn watch_jitter_configs(&self) -> watch::Receiver<HashMap<String, JitterConfig>> {
+        self.jitter_configs.subscribe()
+    }
+
+    /// Jitter buffer statistics of a subscribed track, once it has received frames
+    pub async fn jitter_stats(&self, track_name: &str) -> Option<JitterStats> {
+        match self.broadcast_subscription_manager.read().await.as_ref() {
+            Some(manager) => manager.get_jitter_stats(track_name).await,
+            None => None,
+        }
+    }
+
+    /// Choose how a subscribed track's frames reach the data callback
+    ///
+    /// Tracks are delivered inline, on the task reading them, by default. Queuing a track
+    /// starts the delivery threads, which deliver its frames in order. Requires
+    /// `SessionConfig::delivery_threads` > 0.
+    pub fn set_delivery_mode(&self, track_name: &str, mode: DeliveryMode) -> Result<()> {
+        let delivery = self.delivery.as_ref().ok_or_else(|| {
+            WrapperError::InvalidConfig("Session has no delivery threads".to_string())
+        })?;
+        delivery.set_mode(track_name, mode);
+        Ok(())
+    }
+
+    /// Hand frames to a batch callback, one call per batch instead of per frame
+    ///
+    /// Applies to every track and runs alongside the data and frame callbacks; pass `None`
+    /// to go back to per-frame delivery. Batches form on queued tracks, inline tracks hand
+    /// over one frame at a time. Requires `SessionConfig::delivery_threads` > 0.
+    pub fn set_frame_batching(&self, batching: Option<FrameBatching>) -> Result<()> {
+        let delivery = self.delivery.as_ref().ok_or_else(|| {
+            WrapperError::InvalidConfig("Session has no delivery threads".to_string())
+        })?;
+        delivery.set_batching(batching);
+        Ok(())
+    }
+
+    /// Delivery queue depth and callback duration histograms of a subscribed track
+    pub fn delivery_stats(&self, track_name: &str) -> Option<DeliveryStats> {
+        self.delivery.as_ref()?.stats(track_name)
+    }
+
+    /// Delivery queue feeding `receivers` for a track, if the session has delivery threads
+    pub(crate) fn delivery_queue(
+        &self,
+        track_name: &str,
+        receivers: FrameReceivers,
+    ) -> Option<Arc<TrackQueue>> {
+        Some(self.delivery.as_ref()?.queue(track_name, receivers))
+    }
+
+    /// Report groups of a track that were dropped without being delivered
+    pub(crate) async fn notify_groups_skipped(&self, track_name: &str, count: u64) {
+        let _ = self.event_tx.send(SessionEvent::GroupsSkipped {
+            track: track_name.to_string(),
+            count,
+        });
+        if let Some(callback) = self.groups_skipped_callback.read().await.as_ref() {
+            callback(track_name, count);
+        }
+    }
+
     // clear_catalog_cache method removed - catalog caching is now handled by BroadcastSubscriptionManager
 
     /// Create a BroadcastSubscriptionManager for a specific broadcast
@@ -661,15 +1266,41 @@ impl MoqSession {
         catalog_type: CatalogType,
         requested_tracks: Vec<TrackDefinition>,
     ) -> Result<crate::subscription_manager::BroadcastSubscriptionManager> {
-        crate::subscription_manager::BroadcastSubscriptionManager::new(
+        let track_filters = self.track_filters.read().await.clone();
+        crate::subscription_manager::BroadcastSubscriptionManager::with_filters(
             self.clone(),
             broadcast_name,
             catalog_type,
             requested_tracks,
+            track_filters,
         )
         .await
     }
 
+    /// Subscribe to every catalog track matching any of `filters`
+    ///
+    /// Subscriptions are reconciled on each catalog update: new matches are subscribed and
+    /// tracks removed from the catalog are unsubscribed. Tracks passed at creation are kept
+    /// while they are listed in the catalog. An empty list returns to subscribing exactly
+    /// the requested tracks on the next (re)connect. Requires a catalog type.
+    pub async fn set_track_filters(&self, filters: Vec<TrackFilter>) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Subscriber) {
+            return Err(WrapperError::Session("Not a subscriber session".to_string()).into());
+        }
+        if !filters.is_empty() && *self.catalog_type.read().await == CatalogType::None {
+            return Err(WrapperError::InvalidConfig(
+                "Track filters require a catalog type".to_string(),
+            )
+            .into());
+        }
+
+        *self.track_filters.write().await = filters.clone();
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            manager.set_track_filters(filters).await;
+        }
+        Ok(())
+    }
+
     /// Set data callback for the internal subscription manager
     /// Stores the callback in session and applies it to existing manager if present
     pub async fn set_subscription_data_callback<F>(&self, callback: F) -> Result<()>
@@ -696,15 +1327,9 @@ impl MoqSession {
         Ok(())
     }
 
-    /// Create or recreate the BroadcastSubscriptionManager with stored configuration
+    /// Create the BroadcastSubscriptionManager, or resume the active one after a re-announcement
     /// This is the single place where the manager is created
-    async fn create_or_recreate_manager(&self) -> Result<()> {
-        // Stop existing manager if present
-        if let Some(manager) = self.broadcast_subscription_manager.write().await.take() {
-            debug!("Stopping existing BroadcastSubscriptionManager");
-            manager.stop().await;
-        }
-
+    async fn create_or_resume_manager(&self, announced_at: Instant) -> Result<()> {
         // For subscriber sessions, subscribe to the broadcast first to ensure broadcast_consumer is available
         if matches!(self.session_type, SessionType::Subscriber) {
             debug!(
@@ -720,6 +1345,38 @@ impl MoqSession {
             }
         }
 
+        self.start_or_resume_manager(announced_at).await
+    }
+
+    /// Resume the active manager on the current broadcast consumer, or create one
+    async fn start_or_resume_manager(&self, announced_at: Instant) -> Result<()> {
+        // Swap in the new broadcast consumer, keeping live subscriptions
+        if let Some(manager) = self.broadcast_subscription_manager.read().await.as_ref() {
+            if manager.is_active().await {
+                {
+                    let mut state = self.state.write().await;
+                    state.reannouncements += 1;
+                    state.recovering_since = Some(announced_at);
+                }
+                let (_, resubscribed) = manager.resume().await;
+                if resubscribed == 0 {
+                    // Nothing was lost; data kept flowing on the live subscriptions
+                    self.record_first_group().await;
+                }
+                debug!(
+                    "Resumed broadcast '{}' after re-announcement, {} tracks resubscribed",
+                    self.broadcast_name, resubscribed
+                );
+                return Ok(());
+            }
+        }
+
+        // Stop existing manager if present
+        if let Some(manager) = self.broadcast_subscription_manager.write().await.take() {
+            debug!("Stopping existing BroadcastSubscriptionManager");
+            manager.stop().await;
+        }
+
         // Get configuration from session storage
         let catalog_type = self.catalog_type.read().await.clone();
         let requested_tracks = self.requested_tracks.read().await.clone();
@@ -756,11 +1413,21 @@ impl MoqSession {
     }
 }
 
+/// Random starting group sequence, so a restarted publisher doesn't reuse sequences
+/// that relays may still have cached from the previous run
+fn random_group_sequence() -> u64 {
+    rand::thread_rng().gen_range(1..=10000)
+}
+
 #[derive(Clone, Debug)]
 pub struct ConnectionInfo {
     pub connected: bool,
     pub connection_attempts: usize,
     pub last_connection_time: Option<Instant>,
+    /// Re-announcements of the subscribed broadcast handled without recreating subscriptions
+    pub reannouncements: usize,
+    /// Time from the last re-announcement until a resubscribed track received a group
+    pub last_recovery_time: Option<Duration>,
 }
 
 /// Publisher-specific functionality
@@ -787,8 +1454,7 @@ impl MoqSession {
                     .insert(track_def.name.clone(), track_handle);
 
                 // Generate random starting group sequence number for this track
-                let mut rng = rand::thread_rng();
-                let random_start: u64 = rng.gen_range(1..=10000);
+                let random_start = random_group_sequence();
 
                 self.sequence_numbers
                     .write()
@@ -825,6 +1491,7 @@ impl MoqSession {
         tokio::task::block_in_place(|| {
             tokio::runtime::Handle::current().block_on(async {
                 *self.catalog.write().await = Some(catalog);
+                *self.catalog_bytes.write().await = None;
             })
         });
 
@@ -879,27 +1546,230 @@ impl MoqSession {
         }
     }
 
-    /// Publish catalog data to catalog.json track (internal method called during setup)
+    /// Publish a full catalog snapshot to catalog.json (internal method called during setup)
+    ///
+    /// Every snapshot starts a new group whose sequence doubles as the catalog version.
+    /// The group stays open so later changes can be appended as small delta frames, for
+    /// catalog types that support them.
+    /// The serialized snapshot is cached, so republishing an unchanged catalog (e.g. on
+    /// reconnect) doesn't serialize it again.
     async fn publish_catalog(&self) -> Result<()> {
+        let mut catalog_group = self.catalog_group.write().await;
         let catalog_guard = self.catalog.read().await;
         if let Some(catalog) = catalog_guard.as_ref() {
-            let catalog_json = catalog.to_json().map_err(|e| {
-                WrapperError::Session(format!("Failed to serialize catalog: {}", e))
-            })?;
+            let catalog_bytes = {
+                let mut cached = self.catalog_bytes.write().await;
+                match cached.as_ref() {
+                    Some(bytes) => bytes.clone(),
+                    None => {
+                        let encoding = self.catalog_type.read().await.encoding();
+                        let bytes = catalog.encode(encoding).map_err(|e| {
+                            WrapperError::Session(format!("Failed to serialize catalog: {}", e))
+                        })?;
+                        *cached = Some(bytes.clone());
+                        bytes
+                    }
+                }
+            };
 
             // Get the catalog track producer directly to avoid recursion
             let tracks = self.tracks.read().await;
             if let Some(catalog_handle) = tracks.get("catalog.json") {
                 if let Some(track_producer) = &catalog_handle.producer {
                     let mut track_producer = track_producer.clone();
-                    track_producer.write_frame(Bytes::from(catalog_json));
-                    debug!("Published catalog data");
+
+                    let version = {
+                        let mut sequences = self.sequence_numbers.write().await;
+                        let seq = sequences
+                            .entry("catalog.json".to_string())
+                            .or_insert_with(random_group_sequence);
+                        let current = *seq;
+                        *seq += 1;
+                        current
+                    };
+
+                    let mut group =
+                        track_producer.create_group(version.into()).ok_or_else(|| {
+                            WrapperError::Session("Failed to create catalog group".to_string())
+                        })?;
+                    group.write_frame(catalog_bytes);
+
+                    if let Some(previous) = catalog_group.replace(CatalogGroup {
+                        producer: group,
+                        deltas: 0,
+                    }) {
+                        previous.producer.close();
+                    }
+                    debug!("Published catalog snapshot (version {})", version);
                 }
             }
         }
         Ok(())
     }
 
+    /// Apply catalog deltas and publish them if the catalog is already live
+    ///
+    /// Deltas are appended to the open catalog group; once it holds
+    /// `CATALOG_DELTAS_PER_GROUP` deltas, or when the catalog type doesn't support deltas
+    /// (Hang), a fresh snapshot group with the next version is started instead.
+    /// Before the first publish the change is only stored; `create_track_producers`
+    /// publishes the updated catalog once the session connects.
+    async fn update_catalog(&self, patches: Vec<CatalogPatch>) -> Result<()> {
+        // Held across apply and write so deltas reach the wire in the order they were applied
+        let mut catalog_group = self.catalog_group.write().await;
+
+        {
+            let mut catalog = self.catalog.write().await;
+            match catalog.as_mut() {
+                Some(catalog) => {
+                    for patch in &patches {
+                        catalog.apply_patch(patch);
+                    }
+                    *self.catalog_bytes.write().await = None;
+                }
+                None => return Ok(()),
+            }
+        }
+
+        if !self.is_connected().await || !*self.catalog_published.read().await {
+            return Ok(());
+        }
+
+        let catalog_type = self.catalog_type.read().await.clone();
+        match catalog_group.as_mut() {
+            Some(group)
+                if catalog_type.supports_deltas() && group.deltas < CATALOG_DELTAS_PER_GROUP =>
+            {
+                let encoding = catalog_type.encoding();
+                let delta = CatalogPatch::encode(&patches, encoding).map_err(|e| {
+                    WrapperError::Session(format!("Failed to serialize catalog delta: {}", e))
+                })?;
+                group.producer.write_frame(delta);
+                group.deltas += 1;
+                debug!(
+                    "Published catalog delta {} ({} operations)",
+                    group.deltas,
+                    patches.len()
+                );
+                Ok(())
+            }
+            _ => {
+                drop(catalog_group);
+                self.publish_catalog().await
+            }
+        }
+    }
+
+    /// Add a track to a live publisher session
+    ///
+    /// The track producer is created immediately when connected (otherwise on connect)
+    /// and the catalog change announcing the track is published, without reconnecting.
+    pub async fn add_track(&self, track_def: TrackDefinition) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Publisher) {
+            return Err(WrapperError::Session("Not a publisher session".to_string()).into());
+        }
+
+        if track_def.name == "catalog.json" {
+            return Err(WrapperError::InvalidConfig(
+                "catalog.json is a reserved track name".to_string(),
+            )
+            .into());
+        }
+
+        let broadcast_producer = {
+            let state = self.state.read().await;
+            state
+                .broadcast
+                .as_ref()
+                .and_then(|broadcast_handle| broadcast_handle.producer.clone())
+        };
+
+        {
+            let mut tracks = self.tracks.write().await;
+            if tracks.contains_key(&track_def.name) {
+                return Err(WrapperError::Session(format!(
+                    "Track already exists: {}",
+                    track_def.name
+                ))
+                .into());
+            }
+
+            let track = Track::from(track_def.clone());
+            let producer = broadcast_producer
+                .map(|mut broadcast_producer| broadcast_producer.create_track(track.clone()));
+
+            tracks.insert(
+                track_def.name.clone(),
+                TrackHandle {
+                    producer,
+                    track_info: track,
+                    track_definition: Some(track_def.clone()),
+                },
+            );
+        }
+
+        self.sequence_numbers
+            .write()
+            .await
+            .insert(track_def.name.clone(), random_group_sequence());
+
+        self.update_catalog(vec![CatalogPatch::add(&track_def)])
+            .await?;
+
+        info!(
+            "Added track at runtime: {} ({})",
+            track_def.name, track_def.track_type
+        );
+        Ok(())
+    }
+
+    /// Remove a track from a live publisher session
+    ///
+    /// Closes the open group and the track producer, then publishes the catalog change
+    /// removing the track.
+    pub async fn remove_track(&self, track_name: &str) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Publisher) {
+            return Err(WrapperError::Session("Not a publisher session".to_string()).into());
+        }
+
+        if track_name == "catalog.json" {
+            return Err(WrapperError::InvalidConfig(
+                "catalog.json is a reserved track name".to_string(),
+            )
+            .into());
+        }
+
+        let handle = self
+            .tracks
+            .write()
+            .await
+            .remove(track_name)
+            .ok_or_else(|| WrapperError::TrackNotFound(track_name.to_string()))?;
+
+        self.close_group(track_name).await?;
+        self.sequence_numbers.write().await.remove(track_name);
+
+        if let Some(producer) = handle.producer {
+            let broadcast_producer = {
+                let state = self.state.read().await;
+                state
+                    .broadcast
+                    .as_ref()
+                    .and_then(|broadcast_handle| broadcast_handle.producer.clone())
+            };
+            if let Some(mut broadcast_producer) = broadcast_producer {
+                broadcast_producer.remove_track(track_name);
+            }
+            producer.close();
+        }
+
+        self.update_catalog(vec![CatalogPatch::remove(track_name)])
+            .await?;
+
+        info!("Removed track at runtime: {}", track_name);
+        Ok(())
+    }
+
     /// Start a new group for the specified track
     pub async fn start_group(&self, track_name: &str) -> Result<()> {
         if !matches!(self.session_type, SessionType::Publisher) {
@@ -923,6 +1793,18 @@ impl MoqSession {
         // Close any existing group for this track
         self.close_group(track_name).await?;
 
+        let group = self.next_group(track_name).await?;
+
+        // Store the group
+        self.current_groups
+            .write()
+            .await
+            .insert(track_name.to_string(), group);
+        Ok(())
+    }
+
+    /// Create the next group of a track, taking its sequence number
+    async fn next_group(&self, track_name: &str) -> Result<GroupProducer> {
         // Get track producer
         let mut track_producer = {
             let tracks = self.tracks.read().await;
@@ -952,18 +1834,49 @@ impl MoqSession {
             .create_group(sequence.into())
             .ok_or_else(|| WrapperError::Session("Failed to create group".to_string()))?;
 
-        // Store the group
-        self.current_groups
-            .write()
-            .await
-            .insert(track_name.to_string(), group);
-
         debug!("Started group {} for track {}", sequence, track_name);
-        Ok(())
+        Ok(group)
     }
 
     /// Write a frame to the current group of the specified track
     pub async fn write_frame(&self, track_name: &str, data: Bytes) -> Result<()> {
+        self.write_to_group(track_name, |group| group.write_frame(data))
+            .await
+    }
+
+    /// Write a frame made of several parts to the current group, without joining them
+    ///
+    /// Each part goes out as a chunk of the one frame, so a small header and a large
+    /// payload can come from separate buffers.
+    pub async fn write_frame_parts(&self, track_name: &str, parts: Vec<Bytes>) -> Result<()> {
+        self.write_to_group(track_name, |group| {
+            let size = parts.iter().map(|part| part.len() as u64).sum();
+            let mut frame = group.create_frame(Frame { size });
+            for part in parts {
+                frame.write_chunk(part);
+            }
+            frame.close();
+        })
+        .await
+    }
+
+    /// Start a frame of `size` bytes in the current group, to be streamed in chunks
+    ///
+    /// Chunks go out as they are appended, so a large frame needs neither buffering nor a
+    /// copy of the whole. Frames written to the track before the writer finishes follow it.
+    pub async fn begin_frame(&self, track_name: &str, size: u64) -> Result<FrameWriter> {
+        self.write_to_group(track_name, |group| {
+            FrameWriter::new(group.create_frame(Frame { size }), size)
+        })
+        .await
+    }
+
+    /// Run `write` on the track's current group, starting a group if there is none
+    async fn write_to_group<R>(
+        &self,
+        track_name: &str,
+        write: impl FnOnce(&mut GroupProducer) -> R,
+    ) -> Result<R> {
         if !matches!(self.session_type, SessionType::Publisher) {
             return Err(WrapperError::Session("Not a publisher session".to_string()).into());
         }
@@ -994,7 +1907,43 @@ impl MoqSession {
             ))
         })?;
 
-        group.write_frame(data);
+        Ok(write(group))
+    }
+
+    /// Write a run of frames to a track under one connection check and one group lock
+    ///
+    /// A frame flagged `new_group` closes the current group and starts the next; the first
+    /// frame starts a group if the track has none. On error, the frames before the failing
+    /// one have been written.
+    pub async fn write_frames(
+        &self,
+        track_name: &str,
+        frames: impl IntoIterator<Item = FrameSpec>,
+    ) -> Result<()> {
+        if !matches!(self.session_type, SessionType::Publisher) {
+            return Err(WrapperError::Session("Not a publisher session".to_string()).into());
+        }
+
+        if !self.is_connected().await {
+            return Err(WrapperError::Session(
+                "Session not connected - reconnection in progress".to_string(),
+            )
+            .into());
+        }
+
+        let mut groups = self.current_groups.write().await;
+        for frame in frames {
+            if frame.new_group || !groups.contains_key(track_name) {
+                if let Some(group) = groups.remove(track_name) {
+                    group.close();
+                }
+                let group = self.next_group(track_name).await?;
+                groups.insert(track_name.to_string(), group);
+            }
+            if let Some(group) = groups.get_mut(track_name) {
+                group.write_frame(frame.data);
+            }
+        }
         Ok(())
     }
 
@@ -1232,15 +2181,19 @@ impl MoqSession {
     }
 
     /// Internal method to subscribe to a track without the resilient wrapper
+    ///
+    /// `priority` is passed to the publisher, which serves higher-priority subscriptions
+    /// first when bandwidth is short.
     pub async fn subscribe_track_internal(
         &self,
         broadcast_name: &str,
         track_name: &str,
+        priority: u8,
     ) -> Result<TrackConsumer> {
         let broadcast = self.get_broadcast_consumer().await?;
         let track = Track {
             name: track_name.to_string(),
-            priority: 0, // Priority doesn't matter for subscription
+            priority,
         };
 
         let track_consumer = broadcast.subscribe_track(&track);
@@ -1252,3 +2205,409 @@ impl MoqSession {
         Ok(track_consumer)
     }
 }
+
+#[cfg(test)]
+impl MoqSession {
+    /// Serve subscriptions from a local broadcast, as if it had been announced
+    pub(crate) async fn attach_broadcast(&self, broadcast: BroadcastConsumer) {
+        self.state.write().await.broadcast_consumer = Some(broadcast);
+    }
+
+    /// Publish into a local broadcast, as if the session had connected
+    pub(crate) async fn attach_producer(&self, broadcast: BroadcastProducer) -> Result<()> {
+        {
+            let mut state = self.state.write().await;
+            state.connected = true;
+            state.broadcast = Some(BroadcastHandle {
+                producer: Some(broadcast),
+            });
+        }
+        self.create_track_producers().await
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::catalog::CatalogEncoding;
+
+    fn config() -> SessionConfig {
+        let url = url::Url::parse("https://example.com/test").unwrap();
+        let mut config = SessionConfig::new("test", url);
+        config.delivery_threads = 0;
+        config
+    }
+
+    /// Publisher session writing into a local broadcast, and a consumer of it
+    async fn publisher(tracks: &[TrackDefinition]) -> (MoqSession, BroadcastConsumer) {
+        publisher_with_catalog(CatalogType::None, tracks).await
+    }
+
+    async fn publisher_with_catalog(
+        catalog_type: CatalogType,
+        tracks: &[TrackDefinition],
+    ) -> (MoqSession, BroadcastConsumer) {
+        let session =
+            MoqSession::publisher(config(), "test".to_string(), catalog_type, tracks.to_vec())
+                .await
+                .unwrap();
+        let broadcast = Broadcast::produce();
+        session.attach_producer(broadcast.producer).await.unwrap();
+        (session, broadcast.consumer)
+    }
+
+    fn subscribe(broadcast: &BroadcastConsumer, name: &str) -> TrackConsumer {
+        broadcast.subscribe_track(&Track {
+            name: name.to_string(),
+            priority: 0,
+        })
+    }
+
+    /// Read the frames of a closed group
+    async fn read_group(group: &mut moq_lite::GroupConsumer) -> Vec<Bytes> {
+        let mut frames = Vec::new();
+        while let Some(frame) = group.read_frame().await.unwrap() {
+            frames.push(frame);
+        }
+        frames
+    }
+
+    /// Local broadcast carrying a Sesame catalog of `tracks`, and a producer for each track
+    fn announce(tracks: &[TrackDefinition]) -> (BroadcastConsumer, Vec<TrackProducer>) {
+        let mut broadcast = Broadcast::produce();
+        let mut catalog_track = broadcast.producer.create_track(Track {
+            name: "catalog.json".to_string(),
+            priority: 0,
+        });
+        let catalog = Catalog::new(CatalogType::Sesame, tracks).unwrap();
+        catalog_track.write_frame(catalog.encode(CatalogEncoding::Json).unwrap());
+
+        let mut producers = vec![catalog_track];
+        for track in tracks {
+            producers.push(broadcast.producer.create_track(Track {
+                name: track.name.clone(),
+                priority: 0,
+            }));
+        }
+        (broadcast.consumer, producers)
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_reannouncement_resumes_filtered_tracks() {
+        let session =
+            MoqSession::subscriber(config(), "test".to_string(), CatalogType::Sesame, vec![])
+                .await
+                .unwrap();
+        session
+            .set_track_filters(vec![TrackFilter::any()])
+            .await
+            .unwrap();
+        let tracks = [
+            TrackDefinition::video("video", 1),
+            TrackDefinition::audio("audio", 2),
+        ];
+        let active = || async {
+            let manager = session.broadcast_subscription_manager.read().await;
+            let mut active = manager.as_ref().unwrap().get_active_tracks().await;
+            active.sort();
+            active
+        };
+
+        let (broadcast, producers) = announce(&tracks);
+        session.attach_broadcast(broadcast).await;
+        session
+            .start_or_resume_manager(Instant::now())
+            .await
+            .unwrap();
+        for _ in 0..200 {
+            if active().await.len() == 2 {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        assert_eq!(active().await, ["audio", "video"]);
+
+        // The relay drops the broadcast, then announces it again
+        for producer in producers {
+            producer.close();
+        }
+        for _ in 0..200 {
+            if active().await.is_empty() {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        let (broadcast, mut producers) = announce(&tracks);
+        session.attach_broadcast(broadcast).await;
+        session
+            .start_or_resume_manager(Instant::now())
+            .await
+            .unwrap();
+
+        // Recovery completes with the first group, not with the resubscriptions
+        let info = session.connection_info().await;
+        assert_eq!(info.reannouncements, 1);
+        assert!(info.last_recovery_time.is_none());
+
+        producers[1].write_frame(Bytes::from_static(b"frame"));
+        for _ in 0..200 {
+            if session.connection_info().await.last_recovery_time.is_some() {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        assert!(session.connection_info().await.last_recovery_time.is_some());
+        assert_eq!(active().await, ["audio", "video"]);
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_write_frames_splits_groups() {
+        let (session, broadcast) = publisher(&[TrackDefinition::video("video", 1)]).await;
+        let mut track = subscribe(&broadcast, "video");
+        let frame = |data: &'static str, new_group| FrameSpec {
+            data: Bytes::from_static(data.as_bytes()),
+            new_group,
+        };
+
+        // The first frame starts a group without asking; later ones only when flagged
+        session
+            .write_frames(
+                "video",
+                [
+                    frame("a", false),
+                    frame("b", false),
+                    frame("c", true),
+                    frame("d", false),
+                ],
+            )
+            .await
+            .unwrap();
+        session
+            .write_frames("video", [frame("e", false), frame("f", true)])
+            .await
+            .unwrap();
+        session.close_group("video").await.unwrap();
+
+        let mut groups = Vec::new();
+        for _ in 0..3 {
+            let mut group = track.next_group().await.unwrap().unwrap();
+            groups.push((group.info.sequence, read_group(&mut group).await));
+        }
+        let first = groups[0].0;
+        assert_eq!(
+            groups,
+            [
+                (first, vec![Bytes::from("a"), Bytes::from("b")]),
+                (
+                    first + 1,
+                    vec![Bytes::from("c"), Bytes::from("d"), Bytes::from("e")]
+                ),
+                (first + 2, vec![Bytes::from("f")]),
+            ]
+        );
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_write_frame_parts() {
+        let (session, broadcast) = publisher(&[TrackDefinition::video("video", 1)]).await;
+        let mut track = subscribe(&broadcast, "video");
+        let parts = ["header:", "", "payload"].map(|part| Bytes::from_static(part.as_bytes()));
+        session
+            .write_frame_parts("video", parts.to_vec())
+            .await
+            .unwrap();
+        session.close_group("video").await.unwrap();
+
+        // One frame, announced at the total size of its parts
+        let mut group = track.next_group().await.unwrap().unwrap();
+        let mut frame = group.next_frame().await.unwrap().unwrap();
+        assert_eq!(frame.info.size, 14);
+        assert_eq!(
+            frame.read_all().await.unwrap(),
+            Bytes::from("header:payload")
+        );
+        assert!(group.next_frame().await.unwrap().is_none());
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_frame_writer_size() {
+        let (session, broadcast) = publisher(&[TrackDefinition::video("video", 1)]).await;
+        let mut track = subscribe(&broadcast, "video");
+
+        // A chunk overrunning the announced size is refused, and nothing of it is sent
+        let mut writer = session.begin_frame("video", 5).await.unwrap();
+        writer.append(Bytes::from("abc")).unwrap();
+        assert!(writer.append(Bytes::from("def")).is_err());
+        assert_eq!(writer.remaining(), 2);
+        writer.append(Bytes::from("de")).unwrap();
+        writer.finish().unwrap();
+
+        // Finishing short abandons the frame
+        let mut writer = session.begin_frame("video", 4).await.unwrap();
+        writer.append(Bytes::from("ab")).unwrap();
+        assert!(writer.finish().is_err());
+        session.close_group("video").await.unwrap();
+
+        let mut group = track.next_group().await.unwrap().unwrap();
+        let mut frame = group.next_frame().await.unwrap().unwrap();
+        assert_eq!(frame.read_all().await.unwrap(), Bytes::from("abcde"));
+        let mut frame = group.next_frame().await.unwrap().unwrap();
+        assert!(frame.read_all().await.is_err());
+    }
+
+    #[tokio::test]
+    async fn test_connected_ends_on_shutdown() {
+        let session =
+            MoqSession::publisher(config(), "test".to_string(), CatalogType::None, vec![])
+                .await
+                .unwrap();
+
+        // Closed before the connection attempt settles: waiters learn it is over
+        let waiter = session.clone();
+        let connected = tokio::spawn(async move { waiter.connected().await });
+        tokio::task::yield_now().await;
+        session.close_session().await.unwrap();
+        let result = timeout(Duration::from_secs(1), connected).await.unwrap();
+        assert!(result.unwrap().is_err());
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_catalog_deltas_roll_over_to_snapshots() {
+        let video = TrackDefinition::video("video", 1);
+        let (session, broadcast) =
+            publisher_with_catalog(CatalogType::Sesame, std::slice::from_ref(&video)).await;
+        let mut catalog = subscribe(&broadcast, "catalog.json");
+        for i in 0..=CATALOG_DELTAS_PER_GROUP {
+            let track = TrackDefinition::data(format!("data{}", i), 1);
+            session.add_track(track).await.unwrap();
+        }
+
+        // The snapshot group takes a full run of deltas that replay to the same catalog
+        let mut first = catalog.next_group().await.unwrap().unwrap();
+        let frames = read_group(&mut first).await;
+        assert_eq!(frames.len(), 1 + CATALOG_DELTAS_PER_GROUP);
+        let mut replayed = Catalog::decode(&CatalogType::Sesame, &frames[0]).unwrap();
+        assert_eq!(replayed.tracks(), [video]);
+        for delta in &frames[1..] {
+            for patch in CatalogPatch::decode(delta, CatalogEncoding::Json).unwrap() {
+                replayed.apply_patch(&patch);
+            }
+        }
+        assert_eq!(replayed.tracks().len(), 1 + CATALOG_DELTAS_PER_GROUP);
+
+        // The next change starts a snapshot group with the next version
+        let mut second = catalog.next_group().await.unwrap().unwrap();
+        assert_eq!(second.info.sequence, first.info.sequence + 1);
+        let snapshot = second.read_frame().await.unwrap().unwrap();
+        let snapshot = Catalog::decode(&CatalogType::Sesame, &snapshot).unwrap();
+        assert_eq!(snapshot.tracks().len(), 2 + CATALOG_DELTAS_PER_GROUP);
+        let last = format!("data{}", CATALOG_DELTAS_PER_GROUP);
+        assert!(snapshot.tracks().iter().any(|track| track.name == last));
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_hang_catalog_changes_are_snapshots() {
+        let video = TrackDefinition::video("video", 1);
+        let (session, broadcast) =
+            publisher_with_catalog(CatalogType::Hang, std::slice::from_ref(&video)).await;
+        let mut catalog = subscribe(&broadcast, "catalog.json");
+        session
+            .add_track(TrackDefinition::audio("audio", 2))
+            .await
+            .unwrap();
+        session.remove_track("video").await.unwrap();
+
+        // Each change is a group of its own holding only a snapshot
+        let mut versions = Vec::new();
+        let mut snapshots = Vec::new();
+        for _ in 0..3 {
+            let next = timeout(Duration::from_secs(1), catalog.next_group()).await;
+            let mut group = next.expect("catalog group").unwrap().unwrap();
+            versions.push(group.info.sequence);
+            let frame = group.read_frame().await.unwrap().unwrap();
+            snapshots.push(
+                Catalog::decode(&CatalogType::Hang, &frame)
+                    .unwrap()
+                    .tracks(),
+            );
+        }
+        assert_eq!(versions[1], versions[0] + 1);
+        assert_eq!(versions[2], versions[1] + 1);
+        assert_eq!(snapshots[1].len(), 2);
+        assert_eq!(snapshots[2], [TrackDefinition::audio("audio", 2)]);
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_live_track_add_remove() {
+        let video = TrackDefinition::video("video", 1);
+        let (session, broadcast) =
+            publisher_with_catalog(CatalogType::Sesame, std::slice::from_ref(&video)).await;
+        let mut catalog = subscribe(&broadcast, "catalog.json");
+        let mut catalog_group = catalog.next_group().await.unwrap().unwrap();
+        let snapshot = catalog_group.read_frame().await.unwrap().unwrap();
+        let snapshot = Catalog::decode(&CatalogType::Sesame, &snapshot).unwrap();
+        assert_eq!(snapshot.tracks(), [video]);
+
+        // An added track is readable right away and announced in the catalog
+        let audio = TrackDefinition::audio("audio", 2);
+        session.add_track(audio.clone()).await.unwrap();
+        let mut track = subscribe(&broadcast, "audio");
+        session.start_group("audio").await.unwrap();
+        session
+            .write_frame("audio", Bytes::from("sample"))
+            .await
+            .unwrap();
+        let mut group = track.next_group().await.unwrap().unwrap();
+        assert_eq!(
+            group.read_frame().await.unwrap().unwrap(),
+            Bytes::from("sample")
+        );
+        let delta = catalog_group.read_frame().await.unwrap().unwrap();
+        assert_eq!(
+            CatalogPatch::decode(&delta, CatalogEncoding::Json).unwrap(),
+            [CatalogPatch::add(&audio)]
+        );
+
+        // A removed track ends for its readers and leaves the catalog
+        session.remove_track("audio").await.unwrap();
+        assert!(track.next_group().await.unwrap().is_none());
+        let delta = catalog_group.read_frame().await.unwrap().unwrap();
+        assert_eq!(
+            CatalogPatch::decode(&delta, CatalogEncoding::Json).unwrap(),
+            [CatalogPatch::remove("audio")]
+        );
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_catalog_callback_replaced_during_replay() {
+        let session =
+            MoqSession::subscriber(config(), "test".to_string(), CatalogType::Sesame, vec![])
+                .await
+                .unwrap();
+        let catalog = Catalog::new(CatalogType::Sesame, &[TrackDefinition::video("video", 1)]);
+        let snapshot = Arc::new(CatalogSnapshot::new(1, catalog.unwrap()));
+        session.set_catalog_snapshot("test", snapshot).await;
+
+        // The replayed callback installs a replacement and waits for it to be in place
+        let (replaced_tx, replaced_rx) = std::sync::mpsc::channel();
+        let (seen_tx, seen_rx) = std::sync::mpsc::channel();
+        let nested = session.clone();
+        let runtime = tokio::runtime::Handle::current();
+        session
+            .set_catalog_callback(Box::new(move |_| {
+                let (session, runtime) = (nested.clone(), runtime.clone());
+                let seen_tx = seen_tx.clone();
+                let (done_tx, done_rx) = std::sync::mpsc::channel();
+                std::thread::spawn(move || {
+                    runtime.block_on(session.set_catalog_callback(Box::new(move |snapshot| {
+                        let _ = seen_tx.send(snapshot.version());
+                    })));
+                    let _ = done_tx.send(());
+                });
+                let _ = replaced_tx.send(done_rx.recv_timeout(Duration::from_secs(1)).is_ok());
+            }))
+            .await;
+        assert_eq!(replaced_rx.recv_timeout(Duration::from_secs(2)), Ok(true));
+        assert_eq!(seen_rx.recv_timeout(Duration::from_secs(1)), Ok(1));
+    }
+}
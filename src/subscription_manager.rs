@@ -1,19 +1,43 @@
 use anyhow::Result;
-use std::collections::HashMap;
+use std::collections::{BTreeMap, HashMap, HashSet, VecDeque};
 use std::sync::Arc;
-use std::time::Duration;
-use tokio::sync::{broadcast, RwLock};
-use tokio::time::sleep;
+use std::time::{Duration, Instant};
+use tokio::sync::{broadcast, mpsc, watch, Notify, OwnedSemaphorePermit, RwLock, Semaphore};
+use tokio::task::JoinHandle;
 use tracing::{debug, info, warn};
 
-use moq_lite::TrackConsumer;
+use futures_util::FutureExt;
+use moq_lite::{FrameConsumer, GroupConsumer, TrackConsumer};
 
-use crate::catalog::{Catalog, CatalogType, TrackDefinition};
+use crate::catalog::{
+    Catalog, CatalogPatch, CatalogSnapshot, CatalogType, CatalogUpdate, StartPosition,
+    TrackDefinition, TrackFilter,
+};
+use crate::config::{GroupOrder, LatencyPolicy};
+use crate::delivery::TrackQueue;
+use crate::frame::{
+    BufferLoan, BufferTarget, ChunkReceiver, FrameChunk, FrameInfo, FrameReceivers, ReceivedFrame,
+    SequenceStats,
+};
+use crate::jitter::{JitterBuffer, JitterConfig, JitterStats, Playout};
 use crate::session::MoqSession;
 
+/// How long a subscription may hold its `max_concurrent_subscriptions` permit waiting for
+/// its first group; an idle track then waits on without one
+const FIRST_GROUP_PERMIT_TIMEOUT: Duration = Duration::from_secs(5);
+
+/// Frames each concurrently read group may have waiting for delivery, in flight or held
+/// back behind an older group, before its reader stops reading
+const FRAMES_IN_FLIGHT_PER_GROUP: usize = 8;
+
 /// Type alias for track data callback to reduce complexity
 pub type TrackDataCallback = Arc<dyn Fn(String, Vec<u8>) + Send + Sync>;
 
+/// Per-track jitter buffers and sequence counters, shared with the track readers
+type SharedJitterBuffers =
+    Arc<RwLock<HashMap<String, Arc<std::sync::Mutex<JitterBuffer<ReceivedFrame>>>>>>;
+type SharedSequenceStats = Arc<RwLock<HashMap<String, Arc<std::sync::Mutex<SequenceStats>>>>>;
+
 /// Manages catalog and track subscriptions for a broadcast
 /// This class handles the complete flow: Wait for announce -> Subscribe to catalog -> Parse catalog -> Subscribe to tracks
 pub struct BroadcastSubscriptionManager {
@@ -21,14 +45,29 @@ pub struct BroadcastSubscriptionManager {
     broadcast_name: String,
     catalog_type: CatalogType,
     requested_tracks: Vec<TrackDefinition>,
+    // Priority and start position of each track subscribed, requested or from the catalog
+    track_definitions: Arc<RwLock<HashMap<String, TrackDefinition>>>,
 
     // State management
     catalog_consumer: Arc<RwLock<Option<TrackConsumer>>>,
     track_consumers: Arc<RwLock<HashMap<String, TrackConsumer>>>,
+    track_tasks: Arc<RwLock<HashMap<String, JoinHandle<()>>>>,
+    // Bounds subscriptions still waiting for their first group (None = unlimited)
+    subscribe_limit: Option<Arc<Semaphore>>,
+    // Time from subscribe request to first group, per track
+    subscribe_times: Arc<RwLock<HashMap<String, Duration>>>,
+    // Jitter buffers of tracks delivering through one, for statistics
+    jitter_buffers: SharedJitterBuffers,
+    // Group sequence counters, per track
+    sequence_stats: SharedSequenceStats,
     current_catalog: Arc<RwLock<Option<Catalog>>>,
 
+    // Catalog-driven subscription: tracks matching any filter are reconciled on each change
+    track_filters: Arc<RwLock<Vec<TrackFilter>>>,
+    reconcile_trigger: Arc<Notify>,
+
     // Communication channels
-    catalog_update_tx: broadcast::Sender<String>,
+    catalog_update_tx: broadcast::Sender<CatalogUpdate>,
     track_data_callback: Arc<RwLock<Option<TrackDataCallback>>>,
 
     // State tracking
@@ -44,16 +83,52 @@ impl BroadcastSubscriptionManager {
         catalog_type: CatalogType,
         requested_tracks: Vec<TrackDefinition>,
     ) -> Result<Self> {
-        let (catalog_update_tx, _) = broadcast::channel(10);
+        Self::with_filters(
+            session,
+            broadcast_name,
+            catalog_type,
+            requested_tracks,
+            Vec::new(),
+        )
+        .await
+    }
+
+    /// Create a subscription manager that also subscribes to catalog tracks matching
+    /// `track_filters` (see `set_track_filters`)
+    pub async fn with_filters(
+        session: MoqSession,
+        broadcast_name: String,
+        catalog_type: CatalogType,
+        requested_tracks: Vec<TrackDefinition>,
+        track_filters: Vec<TrackFilter>,
+    ) -> Result<Self> {
+        let catalog_update_tx = session.catalog_update_sender();
+        let subscribe_limit = match session.config().max_concurrent_subscriptions {
+            0 => None,
+            limit => Some(Arc::new(Semaphore::new(limit))),
+        };
+
+        let track_definitions = requested_tracks
+            .iter()
+            .map(|track| (track.name.clone(), track.clone()))
+            .collect();
 
         let manager = Self {
             session: session.clone(),
             broadcast_name: broadcast_name.clone(),
             catalog_type,
             requested_tracks,
+            track_definitions: Arc::new(RwLock::new(track_definitions)),
             catalog_consumer: Arc::new(RwLock::new(None)),
             track_consumers: Arc::new(RwLock::new(HashMap::new())),
+            track_tasks: Arc::new(RwLock::new(HashMap::new())),
+            subscribe_limit,
+            subscribe_times: Arc::new(RwLock::new(HashMap::new())),
+            jitter_buffers: Arc::new(RwLock::new(HashMap::new())),
+            sequence_stats: Arc::new(RwLock::new(HashMap::new())),
             current_catalog: Arc::new(RwLock::new(None)),
+            track_filters: Arc::new(RwLock::new(track_filters)),
+            reconcile_trigger: Arc::new(Notify::new()),
             catalog_update_tx,
             track_data_callback: Arc::new(RwLock::new(None)),
             is_active: Arc::new(RwLock::new(false)),
@@ -95,6 +170,40 @@ impl BroadcastSubscriptionManager {
         self.requested_tracks.clone()
     }
 
+    /// Replace the track filters and reconcile subscriptions against the current catalog
+    ///
+    /// While any filter is set, subscriptions follow the catalog: tracks matching a filter
+    /// (or requested by name) are subscribed when they appear and unsubscribed when they
+    /// are removed. Requires a catalog type other than `CatalogType::None`.
+    pub async fn set_track_filters(&self, filters: Vec<TrackFilter>) {
+        if !filters.is_empty() && self.catalog_type == CatalogType::None {
+            warn!("[BroadcastSubscriptionManager] Track filters need a catalog; ignoring them for broadcast: {}", self.broadcast_name);
+        }
+        *self.track_filters.write().await = filters;
+        self.reconcile_trigger.notify_one();
+    }
+
+    /// Get the track filters (used for preserving configuration during recreation)
+    pub async fn get_track_filters(&self) -> Vec<TrackFilter> {
+        self.track_filters.read().await.clone()
+    }
+
+    fn track_subscriptions(&self) -> TrackSubscriptions {
+        TrackSubscriptions {
+            session: self.session.clone(),
+            broadcast_name: self.broadcast_name.clone(),
+            definitions: self.track_definitions.clone(),
+            consumers: self.track_consumers.clone(),
+            tasks: self.track_tasks.clone(),
+            limit: self.subscribe_limit.clone(),
+            times: self.subscribe_times.clone(),
+            jitter_buffers: self.jitter_buffers.clone(),
+            sequence_stats: self.sequence_stats.clone(),
+            data_callback: self.track_data_callback.clone(),
+            is_active: self.is_active.clone(),
+        }
+    }
+
     /// Start the complete subscription flow
     async fn start_subscription_flow(&self) {
         let session = self.session.clone();
@@ -102,12 +211,39 @@ impl BroadcastSubscriptionManager {
         let catalog_type = self.catalog_type.clone();
         let requested_tracks = self.requested_tracks.clone();
         let catalog_consumer = self.catalog_consumer.clone();
-        let track_consumers = self.track_consumers.clone();
         let current_catalog = self.current_catalog.clone();
         let catalog_update_tx = self.catalog_update_tx.clone();
-        let track_data_callback = self.track_data_callback.clone();
-        let is_active = self.is_active.clone();
         let catalog_subscribed = self.catalog_subscribed.clone();
+        let subscriptions = self.track_subscriptions();
+        let filtered = !self.track_filters.read().await.is_empty();
+
+        *self.is_active.write().await = true;
+
+        if catalog_type != CatalogType::None {
+            // Start from the catalog seen before the reconnect: filtered tracks are
+            // subscribed right away, and the fresh catalog is diffed against it
+            if let Some(cached) = self.session.cached_catalog(&broadcast_name).await {
+                info!(
+                    "[BroadcastSubscriptionManager] Using cached catalog v{} for broadcast: {}",
+                    cached.version(),
+                    broadcast_name
+                );
+                *current_catalog.write().await = Some(cached.catalog().clone());
+                self.reconcile_trigger.notify_one();
+            }
+
+            // Subscribe to updates before the catalog is requested so none are missed
+            let updates = catalog_update_tx.subscribe();
+            tokio::spawn(Self::reconcile_filtered_tracks(
+                subscriptions.clone(),
+                requested_tracks.clone(),
+                self.track_filters.clone(),
+                current_catalog.clone(),
+                updates,
+                self.reconcile_trigger.clone(),
+                filtered,
+            ));
+        }
 
         tokio::spawn(async move {
             info!(
@@ -124,6 +260,7 @@ impl BroadcastSubscriptionManager {
                     Self::manage_catalog_subscription(
                         &session,
                         &broadcast_name,
+                        catalog_type.clone(),
                         catalog_consumer.clone(),
                         current_catalog.clone(),
                         catalog_update_tx.clone(),
@@ -134,26 +271,142 @@ impl BroadcastSubscriptionManager {
                 }
             }
 
-            // Step 2: Subscribe to all requested tracks
-            Self::manage_track_subscriptions(
-                &session,
-                &broadcast_name,
-                &requested_tracks,
-                track_consumers.clone(),
-                track_data_callback.clone(),
-                is_active.clone(),
-            )
-            .await;
+            // Step 2: Subscribe to all requested tracks, unless the catalog drives subscriptions
+            if filtered && catalog_type != CatalogType::None {
+                info!("[BroadcastSubscriptionManager] Track filters set; subscriptions follow the catalog for broadcast: {}", broadcast_name);
+            } else {
+                Self::manage_track_subscriptions(&subscriptions, &requested_tracks).await;
+            }
+
+            // Step 3: Tracks subscribed one by one through the session
+            for track_name in session.subscribed_tracks().await {
+                subscriptions.subscribe(track_name).await;
+            }
         });
     }
 
+    /// Keep subscriptions in line with the catalog while track filters are set
+    ///
+    /// Runs on every catalog update and filter change. The desired set is every catalog
+    /// track matching a filter or requested by name; tracks leaving it are unsubscribed.
+    /// When the filters are cleared, subscriptions go back to the requested tracks.
+    /// Reconciliation is state-based, so a lagged update channel only costs a wake-up.
+    async fn reconcile_filtered_tracks(
+        subscriptions: TrackSubscriptions,
+        requested_tracks: Vec<TrackDefinition>,
+        track_filters: Arc<RwLock<Vec<TrackFilter>>>,
+        current_catalog: Arc<RwLock<Option<Catalog>>>,
+        mut updates: broadcast::Receiver<CatalogUpdate>,
+        trigger: Arc<Notify>,
+        mut filtered: bool,
+    ) {
+        loop {
+            tokio::select! {
+                update = updates.recv() => {
+                    if let Err(broadcast::error::RecvError::Closed) = update {
+                        break;
+                    }
+                }
+                _ = trigger.notified() => {}
+            }
+
+            if !*subscriptions.is_active.read().await {
+                break;
+            }
+
+            let filters = track_filters.read().await.clone();
+            if filters.is_empty() {
+                if filtered {
+                    filtered = false;
+                    Self::reconcile_requested_tracks(&subscriptions, &requested_tracks).await;
+                }
+                continue;
+            }
+            filtered = true;
+
+            let desired: Vec<TrackDefinition> = match current_catalog.read().await.as_ref() {
+                Some(catalog) => catalog
+                    .tracks()
+                    .into_iter()
+                    .filter(|track| track.name != "catalog.json")
+                    .filter(|track| {
+                        filters.iter().any(|filter| filter.matches(track))
+                            || requested_tracks.iter().any(|r| r.name == track.name)
+                    })
+                    .collect(),
+                None => continue,
+            };
+            {
+                // Catalog tracks are subscribed with their published priority
+                let mut definitions = subscriptions.definitions.write().await;
+                for track in &desired {
+                    if !requested_tracks.iter().any(|r| r.name == track.name) {
+                        definitions.insert(track.name.clone(), track.clone());
+                    }
+                }
+            }
+            let mut desired: HashSet<String> =
+                desired.into_iter().map(|track| track.name).collect();
+            desired.extend(subscriptions.session.subscribed_tracks().await);
+            let active = subscriptions.active().await;
+
+            for name in active.difference(&desired) {
+                subscriptions.unsubscribe(name).await;
+            }
+            for name in desired.difference(&active) {
+                subscriptions.subscribe(name.clone()).await;
+            }
+            debug!(
+                "[BroadcastSubscriptionManager] Reconciled filtered tracks: {} subscribed",
+                desired.len()
+            );
+        }
+    }
+
+    /// Drop the tracks subscribed only because they matched a filter, and subscribe the
+    /// requested tracks the catalog did not list
+    async fn reconcile_requested_tracks(
+        subscriptions: &TrackSubscriptions,
+        requested_tracks: &[TrackDefinition],
+    ) {
+        let mut desired: HashSet<String> = requested_tracks
+            .iter()
+            .map(|track| track.name.clone())
+            .collect();
+        desired.extend(subscriptions.session.subscribed_tracks().await);
+        subscriptions
+            .definitions
+            .write()
+            .await
+            .retain(|name, _| desired.contains(name));
+        let active = subscriptions.active().await;
+
+        for name in active.difference(&desired) {
+            subscriptions.unsubscribe(name).await;
+        }
+        for name in desired.difference(&active) {
+            subscriptions.subscribe(name.clone()).await;
+        }
+        debug!(
+            "[BroadcastSubscriptionManager] Track filters cleared: {} tracks subscribed",
+            desired.len()
+        );
+    }
+
     /// Manage catalog subscription and updates
+    ///
+    /// The first frame of each catalog group is a full snapshot; later frames in the same
+    /// group are deltas (see `CatalogPatch`) applied in place to the current catalog.
+    /// Only the tracks that were added or removed are reported on `catalog_update_tx`.
+    /// Snapshots are parsed according to the session's catalog type (format and wire
+    /// encoding), and every change is published to the session as a new `CatalogSnapshot`.
     async fn manage_catalog_subscription(
         session: &MoqSession,
         broadcast_name: &str,
+        catalog_type: CatalogType,
         catalog_consumer: Arc<RwLock<Option<TrackConsumer>>>,
         current_catalog: Arc<RwLock<Option<Catalog>>>,
-        catalog_update_tx: broadcast::Sender<String>,
+        catalog_update_tx: broadcast::Sender<CatalogUpdate>,
     ) {
         info!(
             "[BroadcastSubscriptionManager] Subscribing to catalog for broadcast: {}",
@@ -162,35 +415,98 @@ impl BroadcastSubscriptionManager {
 
         // Subscribe to catalog.json - only once
         match session
-            .subscribe_track_internal(broadcast_name, "catalog.json")
+            .subscribe_track_internal(broadcast_name, "catalog.json", 0)
             .await
         {
             Ok(mut track_consumer) => {
                 *catalog_consumer.write().await = Some(track_consumer.clone());
 
                 // Monitor catalog for updates
+                let session = session.clone();
+                let broadcast_name = broadcast_name.to_string();
+                let encoding = catalog_type.encoding();
                 tokio::spawn(async move {
                     while let Ok(Some(mut group)) = track_consumer.next_group().await {
-                        if let Ok(Some(frame)) = group.read_frame().await {
-                            let catalog_json = String::from_utf8_lossy(&frame).to_string();
-                            debug!(
-                                "[BroadcastSubscriptionManager] 📋 Catalog updated ({} bytes)",
-                                catalog_json.len()
-                            );
+                        let version = group.info.sequence;
+
+                        // Snapshot frame
+                        let Ok(Some(frame)) = group.read_frame().await else {
+                            continue;
+                        };
+                        debug!(
+                            "[BroadcastSubscriptionManager] 📋 Catalog snapshot v{} ({} bytes)",
+                            version,
+                            frame.len()
+                        );
+
+                        // Parse and store the catalog; deltas derive the next snapshot
+                        // from the last one
+                        let mut snapshot: Option<Arc<CatalogSnapshot>> = None;
+                        match Catalog::decode(&catalog_type, &frame) {
+                            Ok(catalog) => {
+                                let mut current = current_catalog.write().await;
+                                let mut update = catalog.diff(current.as_ref());
+                                update.version = version;
+                                let full = Arc::new(CatalogSnapshot::new(version, catalog.clone()));
+                                *current = Some(catalog);
+                                drop(current);
 
-                            // Parse and store the catalog
-                            match Catalog::parse_sesame(&catalog_json) {
-                                Ok(sesame_catalog) => {
-                                    let catalog = Catalog::Sesame(sesame_catalog);
-                                    *current_catalog.write().await = Some(catalog);
+                                session
+                                    .set_catalog_snapshot(&broadcast_name, full.clone())
+                                    .await;
+                                snapshot = Some(full);
+                                if !update.is_empty() {
+                                    let _ = catalog_update_tx.send(update);
                                 }
+                            }
+                            Err(e) => {
+                                warn!(
+                                    "[BroadcastSubscriptionManager] ⚠️ Failed to parse catalog: {}",
+                                    e
+                                );
+                            }
+                        }
+
+                        // Delta frames, applied in place on top of the snapshot
+                        while let Ok(Some(frame)) = group.read_frame().await {
+                            let Some(previous) = snapshot.clone() else {
+                                continue;
+                            };
+
+                            let patches = match CatalogPatch::decode(&frame, encoding) {
+                                Ok(patches) => patches,
                                 Err(e) => {
-                                    warn!("[BroadcastSubscriptionManager] ⚠️ Failed to parse catalog: {}", e);
+                                    warn!("[BroadcastSubscriptionManager] ⚠️ Failed to parse catalog delta: {}", e);
+                                    continue;
+                                }
+                            };
+
+                            let mut update = CatalogUpdate {
+                                version,
+                                ..Default::default()
+                            };
+                            let next = current_catalog.write().await.as_mut().map(|catalog| {
+                                for patch in &patches {
+                                    update.merge(catalog.apply_patch(patch));
                                 }
+                                Arc::new(previous.with_patches(version, &patches, catalog))
+                            });
+                            if let Some(next) = next {
+                                session
+                                    .set_catalog_snapshot(&broadcast_name, next.clone())
+                                    .await;
+                                snapshot = Some(next);
                             }
+                            debug!(
+                                "[BroadcastSubscriptionManager] 📋 Catalog delta v{}: +{} -{}",
+                                version,
+                                update.added.len(),
+                                update.removed.len()
+                            );
 
-                            // Broadcast catalog update
-                            if let Err(_e) = catalog_update_tx.send(catalog_json) {}
+                            if !update.is_empty() {
+                                let _ = catalog_update_tx.send(update);
+                            }
                         }
                     }
 
@@ -207,89 +523,118 @@ impl BroadcastSubscriptionManager {
     }
 
     /// Manage subscriptions to all requested tracks
+    ///
+    /// All tracks are requested at once; `max_concurrent_subscriptions` bounds how many
+    /// wait for their first group concurrently.
     async fn manage_track_subscriptions(
-        session: &MoqSession,
-        broadcast_name: &str,
+        subscriptions: &TrackSubscriptions,
         requested_tracks: &[TrackDefinition],
-        track_consumers: Arc<RwLock<HashMap<String, TrackConsumer>>>,
-        track_data_callback: Arc<RwLock<Option<TrackDataCallback>>>,
-        is_active: Arc<RwLock<bool>>,
     ) {
         info!(
             "[BroadcastSubscriptionManager] Subscribing to {} tracks",
             requested_tracks.len()
         );
 
-        *is_active.write().await = true;
-
         for track_def in requested_tracks {
-            let track_name = track_def.name.clone();
-            let session_clone = session.clone();
-            let broadcast_name_clone = broadcast_name.to_string();
-            let track_consumers_clone = track_consumers.clone();
-            let callback_clone = track_data_callback.clone();
-            let is_active_clone = is_active.clone();
-
-            tokio::spawn(async move {
-                // Subscribe to the track
-                match session_clone
-                    .subscribe_track_internal(&broadcast_name_clone, &track_name)
-                    .await
-                {
-                    Ok(mut track_consumer) => {
-                        // Store the consumer
-                        track_consumers_clone
-                            .write()
-                            .await
-                            .insert(track_name.clone(), track_consumer.clone());
-
-                        while *is_active_clone.read().await {
-                            match track_consumer.next_group().await {
-                                Ok(Some(mut group)) => {
-                                    while let Ok(Some(frame)) = group.read_frame().await {
-                                        // Call the data callback if set
-                                        let callback_guard = callback_clone.read().await;
-                                        if let Some(callback) = callback_guard.as_ref() {
-                                            callback(track_name.clone(), frame.to_vec());
-                                        }
-                                    }
-                                }
-                                Ok(None) => {
-                                    info!(
-                                        "[BroadcastSubscriptionManager] Track '{}' stream ended (no more groups)",
-                                        track_name
-                                    );
-                                    break;
-                                }
-                                Err(e) => {
-                                    warn!(
-                                        "[BroadcastSubscriptionManager] Track '{}' error: {}",
-                                        track_name, e
-                                    );
-                                    break;
-                                }
-                            }
-                        }
+            subscriptions.subscribe(track_def.name.clone()).await;
+        }
+    }
 
-                        // Remove from active consumers
-                        track_consumers_clone.write().await.remove(&track_name);
-                        info!(
-                            "[BroadcastSubscriptionManager] Track '{}' subscription ended",
-                            track_name
-                        );
-                    }
-                    Err(e) => {
-                        warn!(
-                            "[BroadcastSubscriptionManager] Failed to subscribe to track '{}': {}",
-                            track_name, e
-                        );
-                    }
-                }
-            });
+    /// Pick up a re-announced broadcast without tearing down live subscriptions
+    ///
+    /// The catalog and every track whose consumer has ended are resubscribed on the
+    /// session's current broadcast consumer; running subscriptions, callbacks and
+    /// per-track state are kept. Returns the number of tracks kept and resubscribed.
+    pub async fn resume(&self) -> (usize, usize) {
+        if self.catalog_type != CatalogType::None && self.catalog_consumer.read().await.is_none() {
+            Self::manage_catalog_subscription(
+                &self.session,
+                &self.broadcast_name,
+                self.catalog_type.clone(),
+                self.catalog_consumer.clone(),
+                self.current_catalog.clone(),
+                self.catalog_update_tx.clone(),
+            )
+            .await;
+        }
 
-            // Small delay between track subscriptions
-            sleep(Duration::from_millis(100)).await;
+        let subscriptions = self.track_subscriptions();
+        let active = subscriptions.active().await;
+        let ended: Vec<String> = self
+            .track_tasks
+            .read()
+            .await
+            .keys()
+            .filter(|name| !active.contains(*name))
+            .cloned()
+            .collect();
+        for name in &ended {
+            subscriptions.subscribe(name.clone()).await;
         }
+        self.reconcile_trigger.notify_one();
+
+        info!(
+            "[BroadcastSubscriptionManager] Resumed broadcast {}: {} tracks kept, {} resubscribed",
+            self.broadcast_name,
+            active.len(),
+            ended.len()
+        );
+        (active.len(), ended.len())
+    }
+
+    /// End a track's upstream subscription so the publisher stops sending it
+    ///
+    /// Per-track state (statistics, jitter buffer settings, delivery queue) is kept, and
+    /// the track stays paused across catalog updates and re-announcements until resumed.
+    /// The caller records the pause on the session first (see `MoqSession::pause_track`).
+    pub async fn pause_track(&self, track_name: &str) {
+        let subscriptions = self.track_subscriptions();
+        subscriptions.stop(track_name).await;
+        info!(
+            "[BroadcastSubscriptionManager] Paused track '{}'",
+            track_name
+        );
+    }
+
+    /// Subscribe afresh to a running track, picking up settings read at subscribe time
+    pub async fn restart_track(&self, track_name: &str) {
+        let subscriptions = self.track_subscriptions();
+        if !subscriptions.active().await.contains(track_name) {
+            return;
+        }
+        subscriptions.stop(track_name).await;
+        subscriptions.subscribe(track_name.to_string()).await;
+    }
+
+    /// Subscribe to a track on behalf of `MoqSession::subscribe_track`
+    pub async fn subscribe_track(&self, track_name: &str) {
+        // Otherwise picked up when the subscription flow starts
+        if !*self.is_active.read().await {
+            return;
+        }
+        self.track_subscriptions()
+            .subscribe(track_name.to_string())
+            .await;
+    }
+
+    /// Drop a track subscribed only through `MoqSession::subscribe_track`
+    pub async fn unsubscribe_track(&self, track_name: &str) {
+        if self.track_definitions.read().await.contains_key(track_name) {
+            return;
+        }
+        self.track_subscriptions().unsubscribe(track_name).await;
+    }
+
+    /// Subscribe again to a paused track, with its original priority and start position
+    pub async fn resume_track(&self, track_name: &str) {
+        let known = self.track_definitions.read().await.contains_key(track_name);
+        if known {
+            self.track_subscriptions()
+                .subscribe(track_name.to_string())
+                .await;
+        }
+        // Filtered tracks are picked up again by the next reconciliation
+        self.reconcile_trigger.notify_one();
     }
 
     /// Get the current catalog
@@ -297,6 +642,25 @@ impl BroadcastSubscriptionManager {
         self.current_catalog.read().await.clone()
     }
 
+    /// Time from subscribe request to first group for each track that has received data
+    pub async fn get_subscribe_times(&self) -> HashMap<String, Duration> {
+        self.subscribe_times.read().await.clone()
+    }
+
+    /// Jitter buffer statistics of a track delivering through one
+    pub async fn get_jitter_stats(&self, track_name: &str) -> Option<JitterStats> {
+        let buffers = self.jitter_buffers.read().await;
+        let buffer = buffers.get(track_name)?.lock().ok()?;
+        Some(buffer.stats())
+    }
+
+    /// Group sequence counters of a subscribed track
+    pub async fn get_sequence_stats(&self, track_name: &str) -> Option<SequenceStats> {
+        let stats = self.sequence_stats.read().await;
+        let stats = stats.get(track_name)?.lock().ok()?;
+        Some(*stats)
+    }
+
     /// Get list of active track subscriptions
     pub async fn get_active_tracks(&self) -> Vec<String> {
         self.track_consumers.read().await.keys().cloned().collect()
@@ -310,8 +674,12 @@ impl BroadcastSubscriptionManager {
         );
 
         *self.is_active.write().await = false;
+        self.reconcile_trigger.notify_one();
         *self.catalog_subscribed.write().await = false;
         *self.catalog_consumer.write().await = None;
+        for (_, task) in self.track_tasks.write().await.drain() {
+            task.abort();
+        }
         self.track_consumers.write().await.clear();
         *self.current_catalog.write().await = None;
     }
@@ -321,3 +689,1550 @@ impl BroadcastSubscriptionManager {
         *self.is_active.read().await
     }
 }
+
+/// Shared state needed to start and stop individual track subscriptions
+#[derive(Clone)]
+struct TrackSubscriptions {
+    session: MoqSession,
+    broadcast_name: String,
+    definitions: Arc<RwLock<HashMap<String, TrackDefinition>>>,
+    consumers: Arc<RwLock<HashMap<String, TrackConsumer>>>,
+    tasks: Arc<RwLock<HashMap<String, JoinHandle<()>>>>,
+    limit: Option<Arc<Semaphore>>,
+    times: Arc<RwLock<HashMap<String, Duration>>>,
+    jitter_buffers: SharedJitterBuffers,
+    sequence_stats: SharedSequenceStats,
+    data_callback: Arc<RwLock<Option<TrackDataCallback>>>,
+    is_active: Arc<RwLock<bool>>,
+}
+
+impl TrackSubscriptions {
+    /// Names of tracks with a running subscription
+    async fn active(&self) -> HashSet<String> {
+        self.tasks
+            .read()
+            .await
+            .iter()
+            .filter(|(_, task)| !task.is_finished())
+            .map(|(name, _)| name.clone())
+            .collect()
+    }
+
+    /// Subscribe to a track and deliver its frames to the data callback
+    ///
+    /// Does nothing if a subscription for the track is already running or the track is
+    /// paused.
+    async fn subscribe(&self, track_name: String) {
+        if self.session.is_track_paused(&track_name).await {
+            debug!(
+                "[BroadcastSubscriptionManager] Track '{}' is paused; not subscribing",
+                track_name
+            );
+            return;
+        }
+
+        let mut tasks = self.tasks.write().await;
+        if tasks
+            .get(&track_name)
+            .is_some_and(|task| !task.is_finished())
+        {
+            return;
+        }
+
+        let subscriptions = self.clone();
+        let name = track_name.clone();
+        let requested_at = Instant::now();
+        let task = tokio::spawn(async move { subscriptions.run(name, requested_at).await });
+        tasks.insert(track_name, task);
+    }
+
+    /// Stop a track subscription; dropping its consumer ends the subscription upstream
+    async fn unsubscribe(&self, track_name: &str) {
+        self.stop(track_name).await;
+        self.times.write().await.remove(track_name);
+        self.jitter_buffers.write().await.remove(track_name);
+        self.sequence_stats.write().await.remove(track_name);
+        info!(
+            "[BroadcastSubscriptionManager] Unsubscribed from track '{}'",
+            track_name
+        );
+    }
+
+    /// End a track's upstream subscription, keeping its statistics and definition
+    async fn stop(&self, track_name: &str) {
+        if let Some(task) = self.tasks.write().await.remove(track_name) {
+            task.abort();
+        }
+        self.consumers.write().await.remove(track_name);
+    }
+
+    async fn run(self, track_name: String, requested_at: Instant) {
+        let definition = self.definitions.read().await.get(&track_name).cloned();
+        let (priority, position) = match &definition {
+            Some(track) => (u8::try_from(track.priority).unwrap_or(u8::MAX), track.start),
+            None => (0, StartPosition::Any),
+        };
+
+        // Held until the first group arrives, the subscription fails, or the wait times out
+        let mut permit = match &self.limit {
+            Some(limit) => match limit.clone().acquire_owned().await {
+                Ok(permit) => Some(permit),
+                Err(_) => return,
+            },
+            None => None,
+        };
+
+        // Subscribe to the track
+        match self
+            .session
+            .subscribe_track_internal(&self.broadcast_name, &track_name, priority)
+            .await
+        {
+            Ok(mut track_consumer) => {
+                // Store the consumer
+                self.consumers
+                    .write()
+                    .await
+                    .insert(track_name.clone(), track_consumer.clone());
+
+                let next = match tokio::time::timeout(
+                    FIRST_GROUP_PERMIT_TIMEOUT,
+                    track_consumer.next_group(),
+                )
+                .await
+                {
+                    Ok(next) => next,
+                    Err(_) => {
+                        // Let other subscriptions through while this track stays idle
+                        drop(permit.take());
+                        track_consumer.next_group().await
+                    }
+                };
+                drop(permit);
+                if let Ok(Some(_)) = next {
+                    let elapsed = requested_at.elapsed();
+                    self.times.write().await.insert(track_name.clone(), elapsed);
+                    info!(
+                        "[BroadcastSubscriptionManager] Track '{}' subscribed in {:?}",
+                        track_name, elapsed
+                    );
+                    self.session.record_first_group().await;
+                }
+
+                let start = Self::start_groups(position, &mut track_consumer, next).await;
+
+                let mut sink = FrameSink::new(self.clone(), track_name.clone()).await;
+                // Chunks go to the callback as they are read, so chunked tracks are read
+                // one group at a time to keep them in order on a single task
+                let window = match sink.targets.chunks {
+                    Some(_) => 1,
+                    None => self.session.config().group_window,
+                };
+                if window > 1 {
+                    self.read_groups_concurrently(&mut sink, &mut track_consumer, start, window)
+                        .await;
+                } else {
+                    self.read_groups_in_order(&mut sink, &mut track_consumer, start)
+                        .await;
+                }
+                sink.close().await;
+
+                // Remove from active consumers
+                self.consumers.write().await.remove(&track_name);
+                info!(
+                    "[BroadcastSubscriptionManager] Track '{}' subscription ended",
+                    track_name
+                );
+            }
+            Err(e) => {
+                warn!(
+                    "[BroadcastSubscriptionManager] Failed to subscribe to track '{}': {}",
+                    track_name, e
+                );
+            }
+        }
+    }
+
+    /// Call the application callbacks, or hand the frame to the track's delivery queue
+    async fn deliver(
+        receivers: &FrameReceivers,
+        queue: Option<&Arc<TrackQueue>>,
+        track_name: &str,
+        frame: ReceivedFrame,
+    ) {
+        match queue {
+            Some(queue) => queue.push(frame).await,
+            None => receivers.deliver(track_name, &frame).await,
+        }
+    }
+
+    /// Choose the groups a subscription starts with, given its first group
+    ///
+    /// `Latest` and `Newest` pick among the groups already waiting behind the first one,
+    /// collected without blocking; `Group` waits for the requested sequence. Returns the
+    /// `next_group` results to read before asking the consumer for more.
+    async fn start_groups(
+        position: StartPosition,
+        track_consumer: &mut TrackConsumer,
+        first: Result<Option<GroupConsumer>, moq_lite::Error>,
+    ) -> VecDeque<Result<Option<GroupConsumer>, moq_lite::Error>> {
+        let mut groups = match first {
+            Ok(Some(group)) => vec![group],
+            other => return VecDeque::from([other]),
+        };
+        let mut ended = None;
+
+        match position {
+            StartPosition::Any => {}
+            StartPosition::Latest | StartPosition::Newest(_) => {
+                while ended.is_none() {
+                    match track_consumer.next_group().now_or_never() {
+                        Some(Ok(Some(group))) => groups.push(group),
+                        Some(other) => ended = Some(other),
+                        None => break,
+                    }
+                }
+                let keep = match position {
+                    StartPosition::Newest(count) => count.max(1),
+                    _ => 1,
+                };
+                groups.sort_by_key(|group| group.info.sequence);
+                let skip = groups.len().saturating_sub(keep);
+                groups.drain(..skip);
+            }
+            StartPosition::Group(sequence) => {
+                while groups
+                    .last()
+                    .is_some_and(|group| group.info.sequence < sequence)
+                {
+                    groups.clear();
+                    match track_consumer.next_group().await {
+                        Ok(Some(group)) => groups.push(group),
+                        other => {
+                            ended = Some(other);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        groups
+            .into_iter()
+            .map(|group| Ok(Some(group)))
+            .chain(ended)
+            .collect()
+    }
+
+    /// Read each group to completion before moving on to the next
+    ///
+    /// With a `LatencyPolicy` on the track, groups arriving while a group is read are
+    /// timestamped as they arrive and checked against it as they queue up, when the oldest
+    /// of them reaches `max_latency`, and once the group is done. When it is exceeded, a
+    /// group still being read is abandoned and all queued groups but the newest are skipped.
+    async fn read_groups_in_order(
+        &self,
+        sink: &mut FrameSink,
+        track_consumer: &mut TrackConsumer,
+        start: VecDeque<Result<Option<GroupConsumer>, moq_lite::Error>>,
+    ) {
+        let track_name = sink.track_name.clone();
+        let track_name = track_name.as_str();
+        let mut pending: VecDeque<(GroupConsumer, Instant)> = VecDeque::new();
+        let mut ended = None;
+        for result in start {
+            match result {
+                Ok(Some(group)) => pending.push_back((group, Instant::now())),
+                other => ended = Some(other),
+            }
+        }
+
+        while *self.is_active.read().await {
+            let next = match (pending.pop_front(), ended.take()) {
+                (Some((group, _)), ended_result) => {
+                    ended = ended_result;
+                    Ok(Some(group))
+                }
+                (None, Some(ended_result)) => ended_result,
+                (None, None) => track_consumer.next_group().await,
+            };
+            let group = match next {
+                Ok(Some(group)) => group,
+                Ok(None) => {
+                    info!(
+                        "[BroadcastSubscriptionManager] Track '{}' stream ended (no more groups)",
+                        track_name
+                    );
+                    break;
+                }
+                Err(e) => {
+                    warn!(
+                        "[BroadcastSubscriptionManager] Track '{}' error: {}",
+                        track_name, e
+                    );
+                    break;
+                }
+            };
+
+            let policy = self.session.latency_policy(track_name).await;
+            let read = async {
+                let mut frames = GroupFrames::new(group, sink.track_id, sink.targets.clone());
+                while let Some(frame) = frames.next().await {
+                    sink.deliver(frame).await;
+                }
+            };
+            let oldest_wait = |pending: &VecDeque<(GroupConsumer, Instant)>| {
+                pending
+                    .front()
+                    .map(|(_, queued_at)| queued_at.elapsed())
+                    .unwrap_or_default()
+            };
+            tokio::pin!(read);
+            let mut abandoned = false;
+            loop {
+                // Time left before the oldest queued group exceeds the latency limit
+                let latency_left = policy
+                    .and_then(|policy| policy.max_latency)
+                    .filter(|_| !pending.is_empty())
+                    .map(|max| max.saturating_sub(oldest_wait(&pending)));
+                tokio::select! {
+                    _ = &mut read => break,
+                    result = track_consumer.next_group(), if policy.is_some() && ended.is_none() => {
+                        match result {
+                            Ok(Some(group)) => pending.push_back((group, Instant::now())),
+                            other => ended = Some(other),
+                        }
+                    }
+                    _ = tokio::time::sleep(latency_left.unwrap_or_default()), if latency_left.is_some() => {}
+                }
+
+                // A stalled or long group must not hold back catching up
+                if policy
+                    .is_some_and(|policy| policy.is_exceeded(pending.len(), oldest_wait(&pending)))
+                {
+                    abandoned = true;
+                    break;
+                }
+            }
+
+            let Some(policy) = policy else {
+                continue;
+            };
+            let queued = pending.len().saturating_sub(1);
+            let skipped = queued + usize::from(abandoned);
+            if abandoned || (queued > 0 && policy.is_exceeded(pending.len(), oldest_wait(&pending)))
+            {
+                pending.drain(..queued);
+                info!(
+                    "[BroadcastSubscriptionManager] Track '{}' skipped {} groups to catch up",
+                    track_name, skipped
+                );
+                self.session
+                    .notify_groups_skipped(track_name, skipped as u64)
+                    .await;
+            }
+        }
+    }
+
+    /// Read up to `window` groups of a track at once, so a stalled group doesn't hold
+    /// back newer ones; frames are released according to the session's `GroupOrder`
+    ///
+    /// Frames read ahead of delivery are bounded per group, so a slow callback or a stalled
+    /// older group holds the readers back.
+    /// With a `LatencyPolicy` on the track, the groups open behind the oldest one count as
+    /// queued; when the policy is exceeded, every open group but the newest is skipped.
+    async fn read_groups_concurrently(
+        &self,
+        sink: &mut FrameSink,
+        track_consumer: &mut TrackConsumer,
+        mut start: VecDeque<Result<Option<GroupConsumer>, moq_lite::Error>>,
+        window: usize,
+    ) {
+        let track_name = sink.track_name.clone();
+        let track_name = track_name.as_str();
+        let (frame_tx, mut frame_rx) = mpsc::channel(window * FRAMES_IN_FLIGHT_PER_GROUP);
+        let mut groups = GroupWindow::new(self.session.config().group_order, window);
+        let mut next = start.pop_front();
+        let mut reported_skips = 0;
+        let mut policy: Option<LatencyPolicy> = None;
+
+        loop {
+            if let Some(policy) = policy {
+                let (pending, oldest_wait) = groups.backlog();
+                if policy.is_exceeded(pending, oldest_wait) {
+                    let skipped = groups.skip_to_newest();
+                    info!(
+                        "[BroadcastSubscriptionManager] Track '{}' skipped {} groups to catch up",
+                        track_name, skipped
+                    );
+                }
+            }
+
+            if groups.skipped > reported_skips {
+                self.session
+                    .notify_groups_skipped(track_name, groups.skipped - reported_skips)
+                    .await;
+                reported_skips = groups.skipped;
+            }
+
+            if let Some(result) = next.take() {
+                match result {
+                    Ok(Some(group)) if *self.is_active.read().await => {
+                        let sequence = group.info.sequence;
+                        policy = self.session.latency_policy(track_name).await;
+                        if groups.accepts(sequence) {
+                            let reader = GroupReader::spawn(
+                                group,
+                                sink.track_id,
+                                sink.targets.clone(),
+                                frame_tx.clone(),
+                            );
+                            groups.insert(sequence, reader);
+                        } else {
+                            debug!(
+                                "[BroadcastSubscriptionManager] Track '{}' dropped stale group {}",
+                                track_name, sequence
+                            );
+                        }
+                    }
+                    Ok(Some(_)) => break,
+                    Ok(None) => {
+                        info!(
+                            "[BroadcastSubscriptionManager] Track '{}' stream ended (no more groups)",
+                            track_name
+                        );
+                        groups.ended = true;
+                    }
+                    Err(e) => {
+                        warn!(
+                            "[BroadcastSubscriptionManager] Track '{}' error: {}",
+                            track_name, e
+                        );
+                        groups.ended = true;
+                    }
+                }
+            }
+
+            // Open the start groups before waiting on the track
+            if let Some(result) = start.pop_front() {
+                next = Some(result);
+                continue;
+            }
+
+            if groups.is_closed() {
+                break;
+            }
+
+            tokio::select! {
+                result = track_consumer.next_group(), if !groups.ended => {
+                    next = Some(result);
+                }
+                Some((sequence, frame)) = frame_rx.recv() => {
+                    let ready = match frame {
+                        Some(frame) => groups.push_frame(sequence, frame),
+                        None => groups.finish(sequence),
+                    };
+                    for ready in ready {
+                        sink.deliver(ready.frame).await;
+                    }
+                }
+            }
+        }
+
+        if groups.skipped > reported_skips {
+            self.session
+                .notify_groups_skipped(track_name, groups.skipped - reported_skips)
+                .await;
+        }
+        if groups.skipped > 0 {
+            debug!(
+                "[BroadcastSubscriptionManager] Track '{}' skipped {} superseded groups",
+                track_name, groups.skipped
+            );
+        }
+    }
+}
+
+/// Delivers the frames of one track to the application callbacks, through a jitter buffer
+/// while one is configured for the track
+struct FrameSink {
+    subscriptions: TrackSubscriptions,
+    track_name: String,
+    track_id: u32,
+    receivers: FrameReceivers,
+    sequence: Arc<std::sync::Mutex<SequenceStats>>,
+    // Jitter buffer settings, re-read only when the session's settings change
+    jitter_configs: watch::Receiver<HashMap<String, JitterConfig>>,
+    jitter_config: Option<JitterConfig>,
+    playout: Option<Playout<ReceivedFrame>>,
+    // Set when the session runs callbacks on delivery threads
+    queue: Option<Arc<TrackQueue>>,
+    // Where group readers hand frames that bypass whole-frame delivery
+    targets: FrameTargets,
+}
+
+impl FrameSink {
+    async fn new(subscriptions: TrackSubscriptions, track_name: String) -> Self {
+        let session = &subscriptions.session;
+        let track_id = session.track_id(&track_name).await;
+        let receivers = session
+            .frame_receivers(track_id, subscriptions.data_callback.clone())
+            .await;
+        let queue = session.delivery_queue(&track_name, receivers.clone());
+        let targets = FrameTargets {
+            chunks: session.chunk_receiver(&track_name).await,
+            buffers: session.buffer_target(&track_name),
+        };
+        let sequence = subscriptions
+            .sequence_stats
+            .write()
+            .await
+            .entry(track_name.clone())
+            .or_default()
+            .clone();
+        let mut jitter_configs = session.watch_jitter_configs();
+        let jitter_config = jitter_configs.borrow_and_update().get(&track_name).copied();
+        Self {
+            subscriptions,
+            track_name,
+            track_id,
+            receivers,
+            sequence,
+            jitter_configs,
+            jitter_config,
+            playout: None,
+            queue,
+            targets,
+        }
+    }
+
+    async fn deliver(&mut self, read: ReadFrame) {
+        let frame = read.frame;
+        if frame.info.frame_index == 0 {
+            if let Ok(mut sequence) = self.sequence.lock() {
+                sequence.record_group(frame.info.group_sequence);
+            }
+        }
+        if read.consumed {
+            return;
+        }
+
+        if self.jitter_configs.has_changed().unwrap_or(false) {
+            self.jitter_config = self
+                .jitter_configs
+                .borrow_and_update()
+                .get(&self.track_name)
+                .copied();
+        }
+
+        match self.jitter_config {
+            Some(config) => {
+                if self
+                    .playout
+                    .as_ref()
+                    .is_none_or(|playout| playout.config() != config)
+                {
+                    let receivers = self.receivers.clone();
+                    let queue = self.queue.clone();
+                    let track_name = self.track_name.clone();
+                    let playout = Playout::start(config, move |frame| {
+                        let receivers = receivers.clone();
+                        let queue = queue.clone();
+                        let track_name = track_name.clone();
+                        async move {
+                            TrackSubscriptions::deliver(
+                                &receivers,
+                                queue.as_ref(),
+                                &track_name,
+                                frame,
+                            )
+                            .await
+                        }
+                    });
+                    self.subscriptions
+                        .jitter_buffers
+                        .write()
+                        .await
+                        .insert(self.track_name.clone(), playout.buffer());
+                    self.playout = Some(playout);
+                }
+                if let Some(playout) = &self.playout {
+                    playout.push(frame);
+                }
+            }
+            None => {
+                if self.playout.is_some() {
+                    self.close().await;
+                }
+                TrackSubscriptions::deliver(
+                    &self.receivers,
+                    self.queue.as_ref(),
+                    &self.track_name,
+                    frame,
+                )
+                .await;
+            }
+        }
+    }
+
+    /// Stop the jitter buffer, if any; frames still buffered are dropped
+    async fn close(&mut self) {
+        if self.playout.take().is_some() {
+            self.subscriptions
+                .jitter_buffers
+                .write()
+                .await
+                .remove(&self.track_name);
+        }
+    }
+}
+
+/// Application hooks that take frames as they are read, ahead of whole-frame delivery
+#[derive(Clone)]
+struct FrameTargets {
+    // Set in chunked delivery mode
+    chunks: Option<ChunkReceiver>,
+    buffers: BufferTarget,
+}
+
+/// A frame read from a group; a consumed frame was already handed to the application
+/// (streamed in chunks or read into a provided buffer) and only carries its metadata
+struct ReadFrame {
+    frame: ReceivedFrame,
+    consumed: bool,
+}
+
+/// Reads the frames of a group along with their position in it
+struct GroupFrames {
+    group: GroupConsumer,
+    track_id: u32,
+    targets: FrameTargets,
+    index: u64,
+    // Result of checking for another frame after the last one was read
+    peeked: Option<Result<Option<FrameConsumer>, moq_lite::Error>>,
+}
+
+impl GroupFrames {
+    fn new(group: GroupConsumer, track_id: u32, targets: FrameTargets) -> Self {
+        Self {
+            group,
+            track_id,
+            targets,
+            index: 0,
+            peeked: None,
+        }
+    }
+
+    /// Next frame of the group, or None once the group ends or fails
+    ///
+    /// The end-of-group flag is set when the group's end is already known after a frame
+    /// is read; nothing is held back waiting for it.
+    async fn next(&mut self) -> Option<ReadFrame> {
+        let next = match self.peeked.take() {
+            Some(next) => next,
+            None => self.group.next_frame().await,
+        };
+        let Ok(Some(mut frame)) = next else {
+            return None;
+        };
+        let mut provided = None;
+        let mut whole = true;
+        let data = if let Some(chunks) = self.targets.chunks.clone() {
+            self.stream(&mut frame, &chunks).await?;
+            None
+        } else {
+            // A buffer too small for the frame goes straight back, empty, and the frame is
+            // read as usual; one dropped mid-read goes back with what was written so far
+            let size = frame.info.size;
+            let loan = self.targets.buffers.provide(size, self.info(false)).await;
+            match loan.filter(|loan| loan.capacity() >= size) {
+                Some(mut loan) => {
+                    whole = read_into(&mut frame, &mut loan).await;
+                    provided = Some(loan);
+                    None
+                }
+                None => Some(frame.read_all().await.ok()?),
+            }
+        };
+
+        if whole {
+            self.peeked = self.group.next_frame().now_or_never();
+        }
+        let info = self.info(matches!(self.peeked, Some(Ok(None))));
+        self.index += 1;
+
+        if let Some(loan) = provided {
+            // The buffer goes back even when the frame was cut short
+            loan.finish(info);
+            if !whole {
+                return None;
+            }
+        }
+        Some(ReadFrame {
+            consumed: data.is_none(),
+            frame: ReceivedFrame {
+                info,
+                data: data.unwrap_or_default(),
+            },
+        })
+    }
+
+    /// Metadata of the frame being read, arriving now
+    fn info(&self, end_of_group: bool) -> FrameInfo {
+        FrameInfo {
+            track_id: self.track_id,
+            group_sequence: self.group.info.sequence,
+            frame_index: self.index,
+            end_of_group,
+            arrival: Instant::now(),
+        }
+    }
+
+    /// Hand each chunk of the frame to the chunk callback as it is read
+    ///
+    /// A frame cut short still gets a last chunk, empty and flagged as an error; a failed
+    /// frame also ends the group.
+    async fn stream(&self, frame: &mut FrameConsumer, chunks: &ChunkReceiver) -> Option<()> {
+        let mut chunk = FrameChunk {
+            track_id: self.track_id,
+            group_sequence: self.group.info.sequence,
+            frame_index: self.index,
+            frame_size: frame.info.size,
+            offset: 0,
+            is_last: frame.info.size == 0,
+            error: false,
+        };
+        if chunk.is_last {
+            chunks.deliver(&chunk, &[]).await;
+            return Some(());
+        }
+        let failed = loop {
+            match frame.read_chunk().await {
+                Ok(Some(data)) => {
+                    chunk.is_last = chunk.offset + data.len() as u64 >= chunk.frame_size;
+                    chunks.deliver(&chunk, &data).await;
+                    chunk.offset += data.len() as u64;
+                    if chunk.is_last {
+                        return Some(());
+                    }
+                }
+                Ok(None) => break false,
+                Err(_) => break true,
+            }
+        };
+        chunk.is_last = true;
+        chunk.error = true;
+        chunks.deliver(&chunk, &[]).await;
+        (!failed).then_some(())
+    }
+}
+
+/// Copy a frame's chunks into the loaned buffer as they arrive, counting them in its `len`
+///
+/// Returns whether the whole frame fit and was read.
+async fn read_into(frame: &mut FrameConsumer, loan: &mut BufferLoan) -> bool {
+    loop {
+        match frame.read_chunk().await {
+            Ok(Some(chunk)) => {
+                let len = loan.len;
+                let Some(target) = loan.buffer().get_mut(len..len + chunk.len()) else {
+                    return false;
+                };
+                target.copy_from_slice(&chunk);
+                loan.len += chunk.len();
+            }
+            Ok(None) => return true,
+            Err(_) => return false,
+        }
+    }
+}
+
+/// A frame read ahead of delivery, holding one of its group's `FRAMES_IN_FLIGHT_PER_GROUP`
+/// slots until it is delivered or dropped
+struct ReadAhead {
+    frame: ReadFrame,
+    _slot: OwnedSemaphorePermit,
+}
+
+/// Reads one group in its own task; the task is aborted when the reader is dropped
+struct GroupReader(JoinHandle<()>);
+
+impl GroupReader {
+    /// Forward every frame of `group` as `(sequence, Some(frame))`, then `(sequence, None)`
+    ///
+    /// Each frame takes a slot before it is read, so a group whose frames are held back
+    /// stops reading once `FRAMES_IN_FLIGHT_PER_GROUP` of them wait for delivery.
+    fn spawn(
+        group: GroupConsumer,
+        track_id: u32,
+        targets: FrameTargets,
+        frame_tx: mpsc::Sender<(u64, Option<ReadAhead>)>,
+    ) -> Self {
+        let sequence = group.info.sequence;
+        let mut frames = GroupFrames::new(group, track_id, targets);
+        let slots = Arc::new(Semaphore::new(FRAMES_IN_FLIGHT_PER_GROUP));
+        Self(tokio::spawn(async move {
+            loop {
+                let Ok(slot) = slots.clone().acquire_owned().await else {
+                    return;
+                };
+                let Some(frame) = frames.next().await else {
+                    break;
+                };
+                let frame = ReadAhead { frame, _slot: slot };
+                if frame_tx.send((sequence, Some(frame))).await.is_err() {
+                    return;
+                }
+            }
+            let _ = frame_tx.send((sequence, None)).await;
+        }))
+    }
+}
+
+impl Drop for GroupReader {
+    fn drop(&mut self) {
+        self.0.abort();
+    }
+}
+
+/// Groups of one track being read at once, and the frames they have produced
+///
+/// Groups older than the oldest one kept are superseded: they are not opened when they
+/// arrive late, and frames still in flight from them are dropped.
+struct GroupWindow<T, F> {
+    order: GroupOrder,
+    capacity: usize,
+    groups: BTreeMap<u64, WindowGroup<T, F>>,
+    // Groups below this sequence are superseded
+    floor: u64,
+    // No more groups will arrive; close once the open ones finish
+    ended: bool,
+    skipped: u64,
+}
+
+struct WindowGroup<T, F> {
+    frames: VecDeque<F>,
+    done: bool,
+    opened: Instant,
+    // Kept alive while the group is open
+    _reader: T,
+}
+
+impl<T, F> GroupWindow<T, F> {
+    fn new(order: GroupOrder, capacity: usize) -> Self {
+        Self {
+            order,
+            capacity: capacity.max(1),
+            groups: BTreeMap::new(),
+            floor: 0,
+            ended: false,
+            skipped: 0,
+        }
+    }
+
+    /// Whether a group arriving now would be opened
+    fn accepts(&self, sequence: u64) -> bool {
+        sequence >= self.floor && !self.groups.contains_key(&sequence)
+    }
+
+    /// Open a group, dropping the oldest one if the window is full
+    fn insert(&mut self, sequence: u64, reader: T) {
+        self.groups.insert(
+            sequence,
+            WindowGroup {
+                frames: VecDeque::new(),
+                done: false,
+                opened: Instant::now(),
+                _reader: reader,
+            },
+        );
+        while self.groups.len() > self.capacity {
+            if let Some((oldest, _)) = self.groups.pop_first() {
+                self.supersede(oldest + 1);
+                self.skipped += 1;
+            }
+        }
+    }
+
+    /// Record a frame; returns the frames that can be delivered now
+    fn push_frame(&mut self, sequence: u64, frame: F) -> Vec<F> {
+        let Some(group) = self.groups.get_mut(&sequence) else {
+            return Vec::new();
+        };
+        match self.order {
+            GroupOrder::Arrival => vec![frame],
+            GroupOrder::Sequence | GroupOrder::SequenceSkipStale => {
+                group.frames.push_back(frame);
+                self.release()
+            }
+        }
+    }
+
+    /// Mark a group as fully read; returns the frames that can be delivered now
+    fn finish(&mut self, sequence: u64) -> Vec<F> {
+        match self.order {
+            GroupOrder::Arrival => {
+                self.groups.remove(&sequence);
+                Vec::new()
+            }
+            GroupOrder::Sequence | GroupOrder::SequenceSkipStale => {
+                let Some(group) = self.groups.get_mut(&sequence) else {
+                    return Vec::new();
+                };
+                group.done = true;
+
+                if self.order == GroupOrder::SequenceSkipStale {
+                    // Older unfinished groups are stale now that a newer one is complete
+                    let stale = self.groups.range(..sequence).count() as u64;
+                    if stale > 0 {
+                        self.groups = self.groups.split_off(&sequence);
+                        self.skipped += stale;
+                    }
+                    self.supersede(sequence);
+                }
+                self.release()
+            }
+        }
+    }
+
+    /// Pop buffered frames of the oldest group, moving on while groups are complete
+    fn release(&mut self) -> Vec<F> {
+        let mut ready = Vec::new();
+        while let Some(mut entry) = self.groups.first_entry() {
+            let sequence = *entry.key();
+            self.floor = self.floor.max(sequence);
+            let group = entry.get_mut();
+            ready.extend(group.frames.drain(..));
+            if !group.done {
+                break;
+            }
+            entry.remove();
+            self.floor = sequence + 1;
+        }
+        ready
+    }
+
+    /// Open groups queued behind the oldest one, and how long the first of them has been open
+    fn backlog(&self) -> (usize, Duration) {
+        let pending = self.groups.len().saturating_sub(1);
+        let oldest_wait = self
+            .groups
+            .values()
+            .nth(1)
+            .map(|group| group.opened.elapsed())
+            .unwrap_or_default();
+        (pending, oldest_wait)
+    }
+
+    /// Drop every open group but the newest; returns the number dropped
+    fn skip_to_newest(&mut self) -> u64 {
+        let Some(&newest) = self.groups.keys().next_back() else {
+            return 0;
+        };
+        let skipped = self.groups.len() as u64 - 1;
+        self.groups = self.groups.split_off(&newest);
+        self.supersede(newest);
+        self.skipped += skipped;
+        skipped
+    }
+
+    fn supersede(&mut self, floor: u64) {
+        self.floor = self.floor.max(floor);
+    }
+
+    /// No groups open and none coming
+    fn is_closed(&self) -> bool {
+        self.ended && self.groups.is_empty()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::catalog::{CatalogEncoding, TrackType};
+    use crate::config::SessionConfig;
+    use crate::frame::{BufferProvider, ProvidedBuffer};
+    use bytes::Bytes;
+    use moq_lite::{Broadcast, BroadcastProducer, TrackProducer};
+
+    fn frame(data: &'static str) -> Bytes {
+        Bytes::from_static(data.as_bytes())
+    }
+
+    /// Subscriber session reading from a local broadcast
+    async fn subscriber(
+        config: SessionConfig,
+        catalog_type: CatalogType,
+        tracks: &[TrackDefinition],
+    ) -> (MoqSession, BroadcastProducer) {
+        let session =
+            MoqSession::subscriber(config, "test".to_string(), catalog_type, tracks.to_vec())
+                .await
+                .unwrap();
+        let broadcast = Broadcast::produce();
+        session.attach_broadcast(broadcast.consumer).await;
+        (session, broadcast.producer)
+    }
+
+    fn config() -> SessionConfig {
+        let mut config =
+            SessionConfig::new("test", url::Url::parse("https://example.com/test").unwrap());
+        config.delivery_threads = 0;
+        config
+    }
+
+    fn create_track(broadcast: &mut BroadcastProducer, name: &str) -> TrackProducer {
+        broadcast.create_track(moq_lite::Track {
+            name: name.to_string(),
+            priority: 0,
+        })
+    }
+
+    /// Publish a Sesame catalog listing `tracks` as a new catalog group
+    fn publish_catalog(catalog_track: &mut TrackProducer, tracks: &[TrackDefinition]) {
+        let catalog = Catalog::new(CatalogType::Sesame, tracks).unwrap();
+        catalog_track.write_frame(catalog.encode(CatalogEncoding::Json).unwrap());
+    }
+
+    /// Wait until exactly `expected` tracks have a running subscription
+    async fn wait_for_active(manager: &BroadcastSubscriptionManager, expected: &[&str]) {
+        let expected: HashSet<String> = expected.iter().map(|name| name.to_string()).collect();
+        for _ in 0..200 {
+            if manager.track_subscriptions().active().await == expected {
+                return;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        assert_eq!(manager.track_subscriptions().active().await, expected);
+    }
+
+    /// Provider lending buffers of `capacity` bytes, and the contents they come back with
+    fn buffer_provider(capacity: usize) -> (BufferProvider, Arc<std::sync::Mutex<Vec<String>>>) {
+        let completed = Arc::new(std::sync::Mutex::new(Vec::new()));
+        let returned = completed.clone();
+        let provider = BufferProvider {
+            provide: Arc::new(move |_, _| Some(Box::new(vec![0u8; capacity]) as ProvidedBuffer)),
+            complete: Arc::new(move |_, _, mut buffer: ProvidedBuffer, len| {
+                let data = &AsMut::<[u8]>::as_mut(&mut *buffer)[..len];
+                returned
+                    .lock()
+                    .unwrap()
+                    .push(String::from_utf8_lossy(data).into_owned());
+            }),
+        };
+        (provider, completed)
+    }
+
+    async fn wait_for_completed(completed: &std::sync::Mutex<Vec<String>>, count: usize) {
+        for _ in 0..200 {
+            if completed.lock().unwrap().len() >= count {
+                return;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+    }
+
+    /// Payloads delivered to the data callback, and group counts reported skipped
+    #[derive(Clone, Default)]
+    struct Received {
+        frames: Arc<std::sync::Mutex<Vec<Vec<u8>>>>,
+        skipped: Arc<std::sync::Mutex<Vec<u64>>>,
+    }
+
+    impl Received {
+        /// Subscribe a new manager to `track`, collecting what it delivers
+        async fn subscribe(
+            session: &MoqSession,
+            track: &str,
+        ) -> (BroadcastSubscriptionManager, Self) {
+            let received = Self::default();
+            let skipped = received.skipped.clone();
+            session
+                .set_groups_skipped_callback(Box::new(move |_, count| {
+                    skipped.lock().unwrap().push(count)
+                }))
+                .await;
+            let manager = BroadcastSubscriptionManager::new(
+                session.clone(),
+                "test".to_string(),
+                CatalogType::None,
+                Vec::new(),
+            )
+            .await
+            .unwrap();
+            let frames = received.frames.clone();
+            manager
+                .set_data_callback(move |_, data| frames.lock().unwrap().push(data))
+                .await;
+            manager.subscribe_track(track).await;
+            (manager, received)
+        }
+
+        /// Wait for `count` frames, then return every frame delivered
+        async fn frames(&self, count: usize) -> Vec<String> {
+            for _ in 0..200 {
+                if self.frames.lock().unwrap().len() >= count {
+                    break;
+                }
+                tokio::time::sleep(Duration::from_millis(10)).await;
+            }
+            let frames = self.frames.lock().unwrap();
+            frames
+                .iter()
+                .map(|data| String::from_utf8_lossy(data).into_owned())
+                .collect()
+        }
+
+        fn skipped(&self) -> Vec<u64> {
+            self.skipped.lock().unwrap().clone()
+        }
+    }
+
+    #[test]
+    fn test_group_window_ordering() {
+        // Arrival: frames pass straight through; the oldest group is dropped when full
+        let mut window = GroupWindow::new(GroupOrder::Arrival, 2);
+        window.insert(1, ());
+        window.insert(2, ());
+        assert_eq!(window.push_frame(2, frame("2a")), vec![frame("2a")]);
+        assert_eq!(window.push_frame(1, frame("1a")), vec![frame("1a")]);
+        window.insert(3, ());
+        assert!(window.push_frame(1, frame("1b")).is_empty());
+        assert!(!window.accepts(1));
+        assert_eq!(window.skipped, 1);
+
+        // Sequence: newer groups wait for the oldest to finish
+        let mut window = GroupWindow::new(GroupOrder::Sequence, 4);
+        window.insert(1, ());
+        window.insert(2, ());
+        assert!(window.push_frame(2, frame("2a")).is_empty());
+        assert_eq!(window.push_frame(1, frame("1a")), vec![frame("1a")]);
+        assert!(window.finish(2).is_empty());
+        assert_eq!(window.finish(1), vec![frame("2a")]);
+        assert!(!window.accepts(1));
+        window.ended = true;
+        assert!(window.is_closed());
+
+        // SequenceSkipStale: a completed newer group supersedes a stalled older one
+        let mut window = GroupWindow::new(GroupOrder::SequenceSkipStale, 4);
+        window.insert(1, ());
+        window.insert(2, ());
+        assert_eq!(window.push_frame(1, frame("1a")), vec![frame("1a")]);
+        assert!(window.push_frame(2, frame("2a")).is_empty());
+        assert_eq!(window.finish(2), vec![frame("2a")]);
+        assert!(window.push_frame(1, frame("1b")).is_empty());
+        assert_eq!(window.skipped, 1);
+        assert!(!window.accepts(2));
+        assert!(window.accepts(3));
+    }
+
+    #[tokio::test]
+    async fn test_start_groups() {
+        let positions = [
+            (StartPosition::Any, vec![0]),
+            (StartPosition::Latest, vec![4]),
+            (StartPosition::Newest(2), vec![3, 4]),
+            (StartPosition::Newest(0), vec![4]),
+            (StartPosition::Group(3), vec![3]),
+            (StartPosition::Group(6), vec![6]),
+        ];
+        for (position, expected) in positions {
+            let mut broadcast = Broadcast::produce();
+            let mut track = create_track(&mut broadcast.producer, "live");
+            for _ in 0..5 {
+                track.write_frame(frame("data"));
+            }
+            let mut consumer = track.consume();
+            let first = consumer.next_group().await;
+
+            // Group(6) waits for groups that are yet to be published
+            let publisher = tokio::spawn(async move {
+                tokio::time::sleep(Duration::from_millis(10)).await;
+                track.write_frame(frame("data"));
+                track.write_frame(frame("data"));
+                track
+            });
+            let start = TrackSubscriptions::start_groups(position, &mut consumer, first).await;
+            let sequences: Vec<u64> = start
+                .into_iter()
+                .map(|group| group.unwrap().unwrap().info.sequence)
+                .collect();
+            assert_eq!(sequences, expected, "{:?}", position);
+            publisher.await.unwrap();
+        }
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_latency_policy_times_group_arrivals() {
+        let (session, mut broadcast) = subscriber(config(), CatalogType::None, &[]).await;
+        let policy = LatencyPolicy {
+            max_latency: Some(Duration::from_millis(50)),
+            max_pending_groups: None,
+        };
+        session.set_latency_policy("live", Some(policy)).await;
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        let mut stalled = group.create_frame(moq_lite::Frame { size: 2 });
+        stalled.write_chunk(frame("0"));
+        let (manager, received) = Received::subscribe(&session, "live").await;
+
+        // Groups 1 and 2 wait behind the stalled group 0 for longer than the policy
+        // allows: group 0 is abandoned mid-frame and group 1 skipped
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        track.write_frame(frame("1"));
+        track.write_frame(frame("2"));
+        assert_eq!(received.frames(1).await, ["2"]);
+        assert_eq!(received.skipped(), [2]);
+
+        // Group 0 completing later delivers nothing
+        stalled.write_chunk(frame("!"));
+        stalled.close();
+        group.close();
+        tokio::time::sleep(Duration::from_millis(50)).await;
+        assert_eq!(received.frames(1).await, ["2"]);
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_latency_policy_abandons_stalled_group() {
+        let (session, mut broadcast) = subscriber(config(), CatalogType::None, &[]).await;
+        let policy = LatencyPolicy {
+            max_latency: None,
+            max_pending_groups: Some(1),
+        };
+        session.set_latency_policy("live", Some(policy)).await;
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        let mut stalled = group.create_frame(moq_lite::Frame { size: 2 });
+        stalled.write_chunk(frame("0"));
+        let (manager, received) = Received::subscribe(&session, "live").await;
+
+        // Group 0 never completes; the second group queued behind it trips the policy
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        track.write_frame(frame("1"));
+        track.write_frame(frame("2"));
+        assert_eq!(received.frames(1).await, ["2"]);
+        assert_eq!(received.skipped(), [2]);
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_latency_policy_skips_nothing_without_backlog() {
+        let (session, mut broadcast) = subscriber(config(), CatalogType::None, &[]).await;
+        let policy = LatencyPolicy {
+            max_latency: None,
+            max_pending_groups: Some(1),
+        };
+        session.set_latency_policy("live", Some(policy)).await;
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        let mut stalled = group.create_frame(moq_lite::Frame { size: 2 });
+        stalled.write_chunk(frame("0"));
+        let (manager, received) = Received::subscribe(&session, "live").await;
+
+        // A single group queued behind a slow one is within the policy: nothing is skipped
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        track.write_frame(frame("1"));
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        stalled.write_chunk(frame("!"));
+        stalled.close();
+        group.close();
+
+        assert_eq!(received.frames(2).await, ["0!", "1"]);
+        assert!(received.skipped().is_empty());
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_latency_policy_with_group_window() {
+        let mut config = config();
+        config.group_window = 4;
+        let (session, mut broadcast) = subscriber(config, CatalogType::None, &[]).await;
+        let policy = LatencyPolicy {
+            max_latency: None,
+            max_pending_groups: Some(1),
+        };
+        session.set_latency_policy("live", Some(policy)).await;
+        let mut track = create_track(&mut broadcast, "live");
+        let mut stalled = Vec::new();
+        for _ in 0..2 {
+            let mut group = track.append_group();
+            let mut frame = group.create_frame(moq_lite::Frame { size: 2 });
+            frame.write_chunk(Bytes::from_static(b"x"));
+            stalled.push((group, frame));
+        }
+        let (manager, received) = Received::subscribe(&session, "live").await;
+
+        // Two groups open behind stalled group 0: all but the newest are skipped
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        track.write_frame(frame("2"));
+        assert_eq!(received.frames(1).await, ["2"]);
+        for _ in 0..200 {
+            if !received.skipped().is_empty() {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        assert_eq!(received.skipped().iter().sum::<u64>(), 2);
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_chunked_frame_cut_short() {
+        let mut config = config();
+        config.group_window = 4;
+        let (session, mut broadcast) = subscriber(config, CatalogType::None, &[]).await;
+        let chunks = Arc::new(std::sync::Mutex::new(Vec::new()));
+        let received = chunks.clone();
+        session
+            .set_chunk_callback(Arc::new(move |_, chunk: &FrameChunk, data: &[u8]| {
+                let chunk = (
+                    chunk.frame_index,
+                    chunk.offset,
+                    data.len(),
+                    chunk.is_last,
+                    chunk.error,
+                );
+                received.lock().unwrap().push(chunk);
+            }))
+            .await;
+        session.set_chunked_delivery("live", true).await;
+
+        // The first frame ends after 2 of its 4 bytes; the group goes on
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        let mut short = group.create_frame(moq_lite::Frame { size: 4 });
+        short.write_chunk(frame("ab"));
+        short.close();
+        group.write_frame(frame("cd"));
+        group.close();
+        let (manager, _) = Received::subscribe(&session, "live").await;
+
+        for _ in 0..200 {
+            if chunks.lock().unwrap().len() >= 3 {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(10)).await;
+        }
+        assert_eq!(
+            *chunks.lock().unwrap(),
+            [
+                (0, 0, 2, false, false),
+                (0, 2, 0, true, true),
+                (1, 0, 2, true, false)
+            ]
+        );
+        manager.stop().await;
+    }
+
+    #[tokio::test]
+    async fn test_group_read_ahead_is_bounded() {
+        let mut broadcast = Broadcast::produce();
+        let mut track = create_track(&mut broadcast.producer, "live");
+        let mut consumer = track.consume();
+        let mut group = track.append_group();
+        for _ in 0..3 * FRAMES_IN_FLIGHT_PER_GROUP {
+            group.write_frame(frame("data"));
+        }
+        group.close();
+        let group = consumer.next_group().await.unwrap().unwrap();
+
+        // Frames held back from delivery stop the reader once its slots are taken
+        let targets = FrameTargets {
+            chunks: None,
+            buffers: BufferTarget {
+                track_name: "live".into(),
+                provider: Arc::new(RwLock::new(None)),
+            },
+        };
+        let (frame_tx, mut frame_rx) = mpsc::channel(4 * FRAMES_IN_FLIGHT_PER_GROUP);
+        let _reader = GroupReader::spawn(group, 0, targets, frame_tx);
+        tokio::time::sleep(Duration::from_millis(50)).await;
+        assert_eq!(frame_rx.len(), FRAMES_IN_FLIGHT_PER_GROUP);
+
+        // Delivering them frees the slots for the next frames
+        let held: Vec<_> = (0..FRAMES_IN_FLIGHT_PER_GROUP)
+            .map(|_| frame_rx.try_recv().unwrap())
+            .collect();
+        tokio::time::sleep(Duration::from_millis(50)).await;
+        assert!(frame_rx.is_empty());
+        drop(held);
+        tokio::time::sleep(Duration::from_millis(50)).await;
+        assert_eq!(frame_rx.len(), FRAMES_IN_FLIGHT_PER_GROUP);
+    }
+
+    #[tokio::test]
+    async fn test_provided_buffer_too_small() {
+        let (session, mut broadcast) = subscriber(config(), CatalogType::None, &[]).await;
+        let (provider, completed) = buffer_provider(3);
+        session.set_buffer_provider(Some(provider)).await;
+
+        // The 4-byte frame comes back empty and is delivered as usual; the group goes on
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        group.write_frame(frame("data"));
+        group.write_frame(frame("ab"));
+        group.write_frame(frame("xyz"));
+        group.close();
+        let (manager, received) = Received::subscribe(&session, "live").await;
+
+        wait_for_completed(&completed, 3).await;
+        assert_eq!(*completed.lock().unwrap(), ["", "ab", "xyz"]);
+        assert_eq!(received.frames(1).await, ["data"]);
+        manager.stop().await;
+    }
+
+    #[tokio::test]
+    async fn test_abandoned_read_returns_buffer() {
+        let (session, mut broadcast) = subscriber(config(), CatalogType::None, &[]).await;
+        let (provider, completed) = buffer_provider(4);
+        session.set_buffer_provider(Some(provider)).await;
+
+        // The frame stalls after 2 of its 4 bytes until the track is unsubscribed
+        let mut track = create_track(&mut broadcast, "live");
+        let mut group = track.append_group();
+        let mut stalled = group.create_frame(moq_lite::Frame { size: 4 });
+        stalled.write_chunk(frame("ab"));
+        let (manager, _) = Received::subscribe(&session, "live").await;
+        wait_for_active(&manager, &["live"]).await;
+        tokio::time::sleep(Duration::from_millis(50)).await;
+        assert!(completed.lock().unwrap().is_empty());
+
+        manager.unsubscribe_track("live").await;
+        wait_for_completed(&completed, 1).await;
+        assert_eq!(*completed.lock().unwrap(), ["ab"]);
+        manager.stop().await;
+    }
+
+    #[tokio::test(start_paused = true)]
+    async fn test_idle_tracks_release_subscribe_permits() {
+        let mut config = config();
+        config.max_concurrent_subscriptions = 2;
+        let (session, mut broadcast) = subscriber(config, CatalogType::None, &[]).await;
+        let mut live = create_track(&mut broadcast, "live");
+        live.write_frame(frame("data"));
+
+        // More tracks that never produce a group than there are permits
+        let idle = (0..3)
+            .map(|i| TrackDefinition::video(format!("idle{}", i), 0))
+            .collect();
+        let manager =
+            BroadcastSubscriptionManager::new(session, "test".to_string(), CatalogType::None, idle)
+                .await
+                .unwrap();
+        tokio::time::sleep(Duration::from_millis(10)).await;
+        manager.subscribe_track("live").await;
+
+        tokio::time::sleep(FIRST_GROUP_PERMIT_TIMEOUT * 3).await;
+        let times = manager.get_subscribe_times().await;
+        assert!(times.contains_key("live"));
+        assert_eq!(times.len(), 1);
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_cached_catalog_subscriptions() {
+        let video = TrackDefinition::video("video", 1);
+        let audio = TrackDefinition::audio("audio", 2);
+        let (session, mut broadcast) = subscriber(config(), CatalogType::Sesame, &[]).await;
+        let mut catalog_track = create_track(&mut broadcast, "catalog.json");
+        let cached = Catalog::new(CatalogType::Sesame, &[video.clone(), audio]).unwrap();
+        session
+            .set_catalog_snapshot("test", Arc::new(CatalogSnapshot::new(1, cached)))
+            .await;
+
+        // Tracks of the cached catalog are subscribed before catalog.json is published
+        let manager = BroadcastSubscriptionManager::with_filters(
+            session,
+            "test".to_string(),
+            CatalogType::Sesame,
+            Vec::new(),
+            vec![TrackFilter::any()],
+        )
+        .await
+        .unwrap();
+        wait_for_active(&manager, &["video", "audio"]).await;
+
+        // The fresh catalog is reconciled against them
+        publish_catalog(&mut catalog_track, &[video]);
+        wait_for_active(&manager, &["video"]).await;
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_priorities_and_pause_across_reconciliation() {
+        let video = TrackDefinition::video("video", 300);
+        let audio = TrackDefinition::audio("audio", 7);
+        let (session, mut broadcast) = subscriber(config(), CatalogType::Sesame, &[]).await;
+        let mut catalog_track = create_track(&mut broadcast, "catalog.json");
+        publish_catalog(&mut catalog_track, &[video.clone(), audio.clone()]);
+        let manager = BroadcastSubscriptionManager::with_filters(
+            session.clone(),
+            "test".to_string(),
+            CatalogType::Sesame,
+            Vec::new(),
+            vec![TrackFilter::any()],
+        )
+        .await
+        .unwrap();
+        wait_for_active(&manager, &["video", "audio"]).await;
+
+        // Catalog priorities reach the subscriptions, clamped to the wire range; a running
+        // subscription registers its consumer shortly after it starts
+        let priority = |name: &'static str| {
+            let consumers = manager.track_consumers.clone();
+            async move {
+                for _ in 0..200 {
+                    if let Some(consumer) = consumers.read().await.get(name) {
+                        return Some(consumer.info.priority);
+                    }
+                    tokio::time::sleep(Duration::from_millis(10)).await;
+                }
+                None
+            }
+        };
+        assert_eq!(priority("video").await, Some(u8::MAX));
+        assert_eq!(priority("audio").await, Some(7));
+
+        // A paused track stays paused when a catalog update is reconciled
+        session.pause_track("audio").await.unwrap();
+        manager.pause_track("audio").await;
+        wait_for_active(&manager, &["video"]).await;
+        publish_catalog(
+            &mut catalog_track,
+            &[video, audio, TrackDefinition::data("data", 1)],
+        );
+        wait_for_active(&manager, &["video", "data"]).await;
+
+        session.resume_track("audio").await.unwrap();
+        manager.resume_track("audio").await;
+        wait_for_active(&manager, &["video", "audio", "data"]).await;
+        assert_eq!(priority("audio").await, Some(7));
+        manager.stop().await;
+    }
+
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_clearing_filters_drops_filtered_tracks() {
+        let video = TrackDefinition::video("video", 1);
+        let audio = TrackDefinition::audio("audio", 2);
+        let (session, mut broadcast) =
+            subscriber(config(), CatalogType::Sesame, std::slice::from_ref(&video)).await;
+        let mut catalog_track = create_track(&mut broadcast, "catalog.json");
+        publish_catalog(&mut catalog_track, &[video.clone(), audio]);
+
+        let manager = BroadcastSubscriptionManager::with_filters(
+            session,
+            "test".to_string(),
+            CatalogType::Sesame,
+            vec![video],
+            vec![TrackFilter::any().with_type(TrackType::Audio)],
+        )
+        .await
+        .unwrap();
+        wait_for_active(&manager, &["video", "audio"]).await;
+
+        manager.set_track_filters(Vec::new()).await;
+        wait_for_active(&manager, &["video"]).await;
+        manager.stop().await;
+    }
+}
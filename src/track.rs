@@ -54,19 +54,28 @@ impl TrackManager {
         broadcast_name: &str,
         track_name: &str,
     ) -> Result<TrackConsumer> {
-        let broadcast = self.session.get_broadcast_consumer().await?;
-        let track_consumer = broadcast.subscribe_track(&Track {
+        self.subscribe_track_with_priority(broadcast_name, track_name, 0)
+            .await
+    }
+
+    /// Subscribe to a track, asking the publisher to serve it with the given priority
+    pub async fn subscribe_track_with_priority(
+        &self,
+        broadcast_name: &str,
+        track_name: &str,
+        priority: u8,
+    ) -> Result<TrackConsumer> {
+        let track = Track {
             name: track_name.to_string(),
-            priority: 0, // Priority doesn't matter for subscription
-        });
+            priority,
+        };
+        let broadcast = self.session.get_broadcast_consumer().await?;
+        let track_consumer = broadcast.subscribe_track(&track);
 
         let handle = TrackHandle {
             producer: None,
             consumer: Some(track_consumer.clone()),
-            track_info: Track {
-                name: track_name.to_string(),
-                priority: 0,
-            },
+            track_info: track,
             last_activity: Instant::now(),
         };
 
@@ -1,7 +1,9 @@
 use std::sync::Arc;
 use std::time::Duration;
 
-use moq_wrapper::{CatalogType, ConnectionConfig, MoqSession, SessionConfig, TrackManager};
+use moq_wrapper::{
+    CatalogType, ConnectionConfig, MoqSession, SessionConfig, TrackDefinition, TrackManager,
+};
 
 /// This is a basic integration test that doesn't require an actual relay server.
 /// It tests the API surface and basic functionality.
@@ -91,6 +93,7 @@ async fn test_configuration() {
     let session_config = SessionConfig {
         broadcast_name: "test-config".to_string(),
         connection: connection_config,
+        ..Default::default()
     };
 
     // Test that configuration is properly stored
@@ -123,4 +126,98 @@ async fn test_session_state() {
     assert!(!info.connected);
     assert_eq!(info.connection_attempts, 0);
     assert!(info.last_connection_time.is_none());
+
+    // Until started, waiting for the connection (or its end) does not complete
+    let wait = Duration::from_millis(10);
+    assert!(tokio::time::timeout(wait, session.connected())
+        .await
+        .is_err());
+    assert!(tokio::time::timeout(wait, session.closed()).await.is_err());
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_runtime_track_add_remove() {
+    let url = url::Url::parse("https://example.com/test").unwrap();
+    let config = SessionConfig::new("test-broadcast", url);
+
+    let session = MoqSession::publisher(
+        config,
+        "test-broadcast".to_string(),
+        CatalogType::Sesame,
+        vec![TrackDefinition::video("camera1", 1)],
+    )
+    .await
+    .unwrap();
+
+    // Tracks can be added and removed before the session connects
+    session
+        .add_track(TrackDefinition::video("camera2", 1))
+        .await
+        .unwrap();
+    assert!(session.list_tracks().await.contains(&"camera2".to_string()));
+    assert!(session
+        .add_track(TrackDefinition::video("camera2", 1))
+        .await
+        .is_err());
+
+    session.remove_track("camera1").await.unwrap();
+    assert!(!session.list_tracks().await.contains(&"camera1".to_string()));
+    assert!(session.remove_track("camera1").await.is_err());
+
+    // The catalog track is managed by the session itself
+    assert!(session.remove_track("catalog.json").await.is_err());
+}
+
+#[tokio::test(flavor = "multi_thread")]
+async fn test_track_subscription() {
+    let url = url::Url::parse("https://example.com/test").unwrap();
+    let config = SessionConfig::new("test-broadcast", url);
+
+    let session = MoqSession::subscriber(
+        config.clone(),
+        "test-broadcast".to_string(),
+        CatalogType::None,
+        vec![TrackDefinition::video("camera1", 1)],
+    )
+    .await
+    .unwrap();
+
+    // The subscription's id is the track's session-wide id
+    let id = session
+        .subscribe_track("camera2", Arc::new(|_info, _data| {}))
+        .await
+        .unwrap();
+    assert_eq!(id, session.track_id("camera2").await);
+    assert_eq!(
+        session.subscribed_tracks().await,
+        vec!["camera2".to_string()]
+    );
+    assert!(session
+        .subscribe_track("camera2", Arc::new(|_info, _data| {}))
+        .await
+        .is_err());
+
+    session.unsubscribe_track(id).await.unwrap();
+    assert!(session.subscribed_tracks().await.is_empty());
+    assert!(session.unsubscribe_track(id).await.is_err());
+
+    // Ids stay stable across subscriptions
+    let again = session
+        .subscribe_track("camera2", Arc::new(|_info, _data| {}))
+        .await
+        .unwrap();
+    assert_eq!(again, id);
+
+    let publisher = MoqSession::publisher(
+        config,
+        "test-broadcast".to_string(),
+        CatalogType::None,
+        vec![],
+    )
+    .await
+    .unwrap();
+    assert!(publisher
+        .subscribe_track("camera1", Arc::new(|_info, _data| {}))
+        .await
+        .is_err());
 }